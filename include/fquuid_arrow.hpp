@@ -0,0 +1,251 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_bulk.hpp"
+
+// Arrow C Data Interface, https://arrow.apache.org/docs/format/CDataInterface.html
+// The definitions are ABI-stable and guarded so they coexist with Arrow's own headers.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C"
+{
+    struct ArrowSchema
+    {
+        const char* format;
+        const char* name;
+        const char* metadata;
+        int64_t flags;
+        int64_t n_children;
+        struct ArrowSchema** children;
+        struct ArrowSchema* dictionary;
+        void (*release)(struct ArrowSchema*);
+        void* private_data;
+    };
+
+    struct ArrowArray
+    {
+        int64_t length;
+        int64_t null_count;
+        int64_t offset;
+        int64_t n_buffers;
+        int64_t n_children;
+        const void** buffers;
+        struct ArrowArray** children;
+        struct ArrowArray* dictionary;
+        void (*release)(struct ArrowArray*);
+        void* private_data;
+    };
+}
+
+#endif
+
+namespace fquuid::detail
+{
+    // uuid columns are FixedSizeBinary(16) of big-endian bytes, optionally tagged as the arrow.uuid extension type
+    struct uuid_arrow_format
+    {
+        static constexpr char format[] = "w:16";
+        static constexpr std::string_view extension_name = "arrow.uuid";
+        static constexpr std::string_view name_key = "ARROW:extension:name";
+        static constexpr std::string_view metadata_key = "ARROW:extension:metadata";
+
+        struct schema_data
+        {
+            std::string name;
+            std::string metadata;
+        };
+
+        struct array_data
+        {
+            std::vector<std::byte> bytes;
+            std::shared_ptr<const void> owner;
+            const void* buffers[2];
+        };
+
+        // metadata: int32 pair count, then int32 length and bytes for each key and value, native byte order
+        static void append_int32(std::string& s, size_t v) {
+            auto i = static_cast<int32_t>(v);
+            s.append(reinterpret_cast<const char*>(&i), sizeof(i));
+        }
+
+        static std::string extension_metadata() {
+            std::string s;
+            append_int32(s, 2);
+            for (auto kv : { name_key, extension_name, metadata_key, std::string_view{} }) {
+                append_int32(s, kv.size());
+                s.append(kv);
+            }
+            return s;
+        }
+
+        static void release_schema(ArrowSchema* schema) noexcept {
+            delete static_cast<schema_data*>(schema->private_data);
+            schema->release = nullptr;
+        }
+
+        static void release_array(ArrowArray* array) noexcept {
+            delete static_cast<array_data*>(array->private_data);
+            array->release = nullptr;
+        }
+
+        static void export_array(std::unique_ptr<array_data> data, const std::byte* bytes, size_t n, ArrowArray* out) noexcept {
+            data->buffers[0] = nullptr; // no validity bitmap: no nulls
+            data->buffers[1] = bytes;
+            *out = ArrowArray {
+                .length = static_cast<int64_t>(n),
+                .null_count = 0,
+                .offset = 0,
+                .n_buffers = 2,
+                .n_children = 0,
+                .buffers = data->buffers,
+                .children = nullptr,
+                .dictionary = nullptr,
+                .release = release_array,
+                .private_data = data.release(),
+            };
+        }
+
+        static const std::byte* values(const ArrowSchema& schema, const ArrowArray& array) {
+            if (schema.release == nullptr || array.release == nullptr || schema.format == nullptr
+                || std::strcmp(schema.format, format) != 0)
+                throw std::invalid_argument("fquuid:import_arrow: not a FixedSizeBinary(16) array");
+            if (array.length < 0 || array.offset < 0 || array.null_count < -1 || array.n_buffers != 2 || array.buffers == nullptr
+                || (array.length > 0 && array.buffers[1] == nullptr))
+                throw std::invalid_argument("fquuid:import_arrow: invalid array");
+            return static_cast<const std::byte*>(array.buffers[1]) + 16 * array.offset;
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Fills out with a uuid column schema, as the arrow.uuid extension type or as plain FixedSizeBinary(16).
+    // The consumer calls out->release.
+    inline void export_arrow_schema(ArrowSchema* out, bool extension_type = true, std::string_view name = {}) {
+        using format = detail::uuid_arrow_format;
+        auto data = std::make_unique<format::schema_data>();
+        data->name = name;
+        if (extension_type)
+            data->metadata = format::extension_metadata();
+
+        *out = ArrowSchema {
+            .format = format::format,
+            .name = data->name.c_str(),
+            .metadata = extension_type ? data->metadata.data() : nullptr,
+            .flags = ARROW_FLAG_NULLABLE,
+            .n_children = 0,
+            .children = nullptr,
+            .dictionary = nullptr,
+            .release = format::release_schema,
+            .private_data = data.release(),
+        };
+    }
+
+    // Exports keys as a FixedSizeBinary(16) array, converted to big-endian bytes with store_many.
+    // The consumer calls out->release.
+    inline void export_arrow_array(std::span<const uuid> keys, ArrowArray* out) {
+        auto data = std::make_unique<detail::uuid_arrow_format::array_data>();
+        data->bytes.resize(16 * keys.size());
+        store_many(keys, std::span(data->bytes));
+        auto p = data->bytes.data();
+        detail::uuid_arrow_format::export_array(std::move(data), p, keys.size(), out);
+    }
+
+    // Exports big-endian 16-byte records without copying them.
+    // owner keeps the bytes alive until the consumer calls out->release.
+    inline void export_arrow_array(std::span<const std::byte> bytes, std::shared_ptr<const void> owner, ArrowArray* out) {
+        if (bytes.size() % 16 != 0)
+            throw std::invalid_argument("fquuid:export_arrow_array: input size not a multiple of 16");
+        auto data = std::make_unique<detail::uuid_arrow_format::array_data>();
+        data->owner = std::move(owner);
+        detail::uuid_arrow_format::export_array(std::move(data), bytes.data(), bytes.size() / 16, out);
+    }
+
+    // Exports big-endian 16-byte records, taking over the buffer without copying it
+    inline void export_arrow_array(std::vector<std::byte>&& bytes, ArrowArray* out) {
+        if (bytes.size() % 16 != 0)
+            throw std::invalid_argument("fquuid:export_arrow_array: input size not a multiple of 16");
+        auto data = std::make_unique<detail::uuid_arrow_format::array_data>();
+        data->bytes = std::move(bytes);
+        auto p = data->bytes.data();
+        auto n = data->bytes.size() / 16;
+        detail::uuid_arrow_format::export_array(std::move(data), p, n, out);
+    }
+
+    // true when the schema carries the arrow.uuid extension name
+    inline bool is_arrow_uuid_extension(const ArrowSchema& schema) noexcept {
+        using format = detail::uuid_arrow_format;
+        if (schema.metadata == nullptr)
+            return false;
+
+        auto p = schema.metadata;
+        auto read_int32 = [&] {
+            int32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            p += sizeof(v);
+            return std::max(v, 0);
+        };
+        auto next = [&] {
+            std::string_view s(p, static_cast<size_t>(read_int32()));
+            p += s.size();
+            return s;
+        };
+
+        for (int32_t i = 0, pairs = read_int32(); i < pairs; i++) {
+            auto key = next();
+            auto value = next();
+            if (key == format::name_key)
+                return value == format::extension_name;
+        }
+        return false;
+    }
+
+    // The array's 16-byte big-endian records, without copying. Null slots hold unspecified bytes.
+    // The view is valid until the producer's release callback runs.
+    inline std::span<const std::byte> arrow_uuid_bytes(const ArrowSchema& schema, const ArrowArray& array) {
+        auto p = detail::uuid_arrow_format::values(schema, array);
+        return { p, 16 * static_cast<size_t>(array.length) };
+    }
+
+    // Converts the array with load_many, nulls become the nil uuid. Returns array.length.
+    // The array stays owned by the caller.
+    inline size_t import_arrow(const ArrowSchema& schema, const ArrowArray& array, std::span<uuid> out) {
+        auto bytes = arrow_uuid_bytes(schema, array);
+        auto n = static_cast<size_t>(array.length);
+        if (out.size() < n)
+            throw std::invalid_argument("fquuid:import_arrow: output span size insufficient");
+        load_many(bytes, out.first(n));
+
+        auto validity = static_cast<const uint8_t*>(array.buffers[0]);
+        if (validity != nullptr && array.null_count != 0) {
+            for (size_t i = 0; i < n; i++) {
+                auto bit = static_cast<size_t>(array.offset) + i;
+                if ((validity[bit / 8] >> (bit % 8) & 1) == 0)
+                    out[i] = uuid{};
+            }
+        }
+        return n;
+    }
+
+    inline std::vector<uuid> import_arrow(const ArrowSchema& schema, const ArrowArray& array) {
+        std::vector<uuid> v(static_cast<size_t>(std::max<int64_t>(array.length, 0)));
+        import_arrow(schema, array, v);
+        return v;
+    }
+}
@@ -0,0 +1,301 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include "fquuid_uuid.hpp"
+#include "fquuid_simd.hpp"
+
+// 16-byte compare-and-swap: cmpxchg16b on x86-64, detected at run time.
+// Define FQUUID_NO_SIMD to force the portable seqlock.
+#if !defined(FQUUID_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(_MSC_VER))
+#   define FQUUID_ATOMIC_CMPXCHG16B 1
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       include <intrin.h>
+#   else
+#       include <cpuid.h>
+#   endif
+#endif
+
+namespace fquuid::detail
+{
+    struct uuid_atomic_ops
+    {
+        using words = std::array<uint64_t, 2>;
+
+        static void pause() noexcept {
+#if defined(FQUUID_SIMD_SSE2)
+            _mm_pause();
+#endif
+        }
+
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+        // CPUID.01H:ECX
+        static uint32_t cpuid_ecx() noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4];
+            __cpuid(info, 1);
+            return static_cast<uint32_t>(info[2]);
+#else
+            unsigned a, b, c, d;
+            return __get_cpuid(1, &a, &b, &c, &d) ? c : 0;
+#endif
+        }
+
+        static bool has_cmpxchg16b() noexcept {
+#if defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+            return true;
+#else
+            static const bool cx16 = (cpuid_ecx() >> 13 & 1) != 0;
+            return cx16;
+#endif
+        }
+
+        // CPUs enumerating AVX guarantee that aligned 16-byte SSE loads and stores are atomic
+        // (Intel SDM 9.1.1, AMD APM 7.3.2), so load() and store() need no locked instruction
+        static bool has_atomic_sse() noexcept {
+            static const bool avx = (cpuid_ecx() >> 28 & 1) != 0;
+            return avx;
+        }
+
+        // *p == expected ? (*p = desired, true) : (expected = *p, false); a full barrier
+        static bool cas(uint64_t* p, words& expected, const words& desired) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return _InterlockedCompareExchange128(reinterpret_cast<volatile long long*>(p),
+                static_cast<long long>(desired[1]), static_cast<long long>(desired[0]),
+                reinterpret_cast<long long*>(expected.data())) != 0;
+#else
+            bool ok;
+            __asm__ __volatile__("lock cmpxchg16b %1"
+                : "=@ccz"(ok), "+m"(*reinterpret_cast<words*>(p)), "+a"(expected[0]), "+d"(expected[1])
+                : "b"(desired[0]), "c"(desired[1])
+                : "memory");
+            return ok;
+#endif
+        }
+
+        static words load_sse(const uint64_t* p) noexcept {
+#if defined(_MSC_VER) && !defined(__clang__)
+            _ReadWriteBarrier();
+            auto v = _mm_load_si128(reinterpret_cast<const __m128i*>(p));
+            _ReadWriteBarrier();
+#else
+            __m128i v;
+            __asm__ __volatile__("movdqa %1, %0" : "=x"(v) : "m"(*reinterpret_cast<const words*>(p)) : "memory");
+#endif
+            return std::bit_cast<words>(v);
+        }
+
+        static void store_sse(uint64_t* p, const words& w, std::memory_order order) noexcept {
+            auto v = std::bit_cast<__m128i>(w);
+#if defined(_MSC_VER) && !defined(__clang__)
+            _ReadWriteBarrier();
+            _mm_store_si128(reinterpret_cast<__m128i*>(p), v);
+            if (order == std::memory_order_seq_cst)
+                _mm_mfence();
+            _ReadWriteBarrier();
+#else
+            __asm__ __volatile__("movdqa %1, %0" : "=m"(*reinterpret_cast<words*>(p)) : "x"(v) : "memory");
+            if (order == std::memory_order_seq_cst)
+                __asm__ __volatile__("mfence" ::: "memory");
+#endif
+        }
+#endif
+    };
+}
+
+namespace fquuid
+{
+    // std::atomic<uuid> without a lock where the CPU allows.
+    //
+    // On x86-64 with cmpxchg16b (checked once at run time) every operation is lock-free:
+    // compare_exchange and exchange are lock cmpxchg16b, and on CPUs with AVX, where aligned
+    // 16-byte SSE accesses are atomic, load and store are plain movdqa, so readers do not contend.
+    // Elsewhere a seqlock: readers retry while a writer is active, writers take turns.
+    // Every operation is at least as strong as the memory order asked for.
+    class atomic_uuid
+    {
+        using ops = detail::uuid_atomic_ops;
+        using words = ops::words;
+
+        // the words are accessed through ops or std::atomic_ref only
+        alignas(16) mutable uint64_t w_[2];
+        std::atomic<uint32_t> seq_ = 0; // seqlock only, odd while a writer is active
+
+        static bool cas_available() noexcept {
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            return ops::has_cmpxchg16b();
+#else
+            return false;
+#endif
+        }
+
+        words seqlock_load() const noexcept {
+            for (;;) {
+                auto s = seq_.load(std::memory_order_acquire);
+                if ((s & 1) == 0) {
+                    words w { std::atomic_ref(w_[0]).load(std::memory_order_relaxed),
+                              std::atomic_ref(w_[1]).load(std::memory_order_relaxed) };
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (seq_.load(std::memory_order_relaxed) == s)
+                        return w;
+                }
+                ops::pause();
+            }
+        }
+
+        uint32_t seqlock_lock() noexcept {
+            auto s = seq_.load(std::memory_order_relaxed);
+            for (;;) {
+                if ((s & 1) == 0 && seq_.compare_exchange_weak(s, s + 1, std::memory_order_seq_cst))
+                    break;
+                ops::pause();
+                s = seq_.load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            return s;
+        }
+
+        void seqlock_write(const words& w) noexcept {
+            std::atomic_ref(w_[0]).store(w[0], std::memory_order_relaxed);
+            std::atomic_ref(w_[1]).store(w[1], std::memory_order_relaxed);
+        }
+
+        void seqlock_unlock(uint32_t s) noexcept {
+            seq_.store(s + 2, std::memory_order_seq_cst);
+        }
+
+        // the current words, by a compare-and-swap that rewrites them unchanged when it matches
+        words cas_load() const noexcept {
+            words w {};
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            ops::cas(w_, w, w);
+#endif
+            return w;
+        }
+
+    public:
+        using value_type = uuid;
+
+#if defined(FQUUID_ATOMIC_CMPXCHG16B) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_16)
+        static constexpr bool is_always_lock_free = true;
+#else
+        static constexpr bool is_always_lock_free = false;
+#endif
+
+        atomic_uuid() noexcept : w_{} {}
+
+        atomic_uuid(const uuid& u) noexcept {
+            auto w = std::bit_cast<words>(u);
+            w_[0] = w[0];
+            w_[1] = w[1];
+        }
+
+        atomic_uuid(const atomic_uuid&) = delete;
+        atomic_uuid& operator =(const atomic_uuid&) = delete;
+
+        uuid operator =(const uuid& u) noexcept {
+            store(u);
+            return u;
+        }
+
+        operator uuid() const noexcept {
+            return load();
+        }
+
+        bool is_lock_free() const noexcept {
+            return cas_available();
+        }
+
+        uuid load(std::memory_order order = std::memory_order_seq_cst) const noexcept {
+            (void)order;
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            if (ops::has_atomic_sse())
+                return std::bit_cast<uuid>(ops::load_sse(w_));
+            if (cas_available())
+                return std::bit_cast<uuid>(cas_load());
+#endif
+            return std::bit_cast<uuid>(seqlock_load());
+        }
+
+        void store(const uuid& u, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            auto w = std::bit_cast<words>(u);
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            if (ops::has_atomic_sse())
+                return ops::store_sse(w_, w, order);
+            if (cas_available()) {
+                auto expected = cas_load();
+                while (!ops::cas(w_, expected, w)) {}
+                return;
+            }
+#endif
+            (void)order;
+            auto s = seqlock_lock();
+            seqlock_write(w);
+            seqlock_unlock(s);
+        }
+
+        uuid exchange(const uuid& u, std::memory_order order = std::memory_order_seq_cst) noexcept {
+            (void)order;
+            auto w = std::bit_cast<words>(u);
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            if (cas_available()) {
+                auto expected = std::bit_cast<words>(load(std::memory_order_relaxed));
+                while (!ops::cas(w_, expected, w)) {}
+                return std::bit_cast<uuid>(expected);
+            }
+#endif
+            auto s = seqlock_lock();
+            auto old = words { std::atomic_ref(w_[0]).load(std::memory_order_relaxed),
+                               std::atomic_ref(w_[1]).load(std::memory_order_relaxed) };
+            seqlock_write(w);
+            seqlock_unlock(s);
+            return std::bit_cast<uuid>(old);
+        }
+
+        // Never fails spuriously
+        bool compare_exchange_strong(uuid& expected, const uuid& desired,
+                                     std::memory_order success, std::memory_order failure) noexcept {
+            (void)success;
+            (void)failure;
+            auto e = std::bit_cast<words>(expected);
+            auto d = std::bit_cast<words>(desired);
+#if defined(FQUUID_ATOMIC_CMPXCHG16B)
+            if (cas_available()) {
+                if (ops::cas(w_, e, d))
+                    return true;
+                expected = std::bit_cast<uuid>(e);
+                return false;
+            }
+#endif
+
+            auto s = seqlock_lock();
+            auto current = words { std::atomic_ref(w_[0]).load(std::memory_order_relaxed),
+                                   std::atomic_ref(w_[1]).load(std::memory_order_relaxed) };
+            bool ok = current == e;
+            if (ok)
+                seqlock_write(d);
+            seqlock_unlock(s);
+            if (!ok)
+                expected = std::bit_cast<uuid>(current);
+            return ok;
+        }
+
+        bool compare_exchange_strong(uuid& expected, const uuid& desired,
+                                     std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return compare_exchange_strong(expected, desired, order, order);
+        }
+
+        bool compare_exchange_weak(uuid& expected, const uuid& desired,
+                                   std::memory_order success, std::memory_order failure) noexcept {
+            return compare_exchange_strong(expected, desired, success, failure);
+        }
+
+        bool compare_exchange_weak(uuid& expected, const uuid& desired,
+                                   std::memory_order order = std::memory_order_seq_cst) noexcept {
+            return compare_exchange_strong(expected, desired, order, order);
+        }
+    };
+}
@@ -11,7 +11,7 @@
 
 namespace fquuid::detail
 {
-    template <ByteLike ByteT>
+    template <ByteLike ByteT, UuidLayout Layout = layout::big_endian>
     class uuid_basic_binary
     {
         static constexpr uint64_t to_u64(ByteT b) {
@@ -50,10 +50,32 @@ namespace fquuid::detail
             fixed_at<7>(bytes) = to_byte(x);
         }
 
+        // 00112233-4455-6677 <-> 33221100-5544-7766, its own inverse
+        static constexpr uint64_t swap_guid_fields(uint64_t x) {
+            x = ((x & 0x00ff'00ff'00ff'00ff) << 8) | ((x >> 8) & 0x00ff'00ff'00ff'00ff);
+            return ((x & 0x0000'0000'ffff'ffff) |
+                    ((x << 16) & 0xffff'0000'0000'0000) |
+                    ((x >> 16) & 0x0000'ffff'0000'0000));
+        }
+
+        static constexpr uint64_t load_upper(std::span<const ByteT, 8> bytes) {
+            if constexpr (Layout::mixed_endian)
+                return swap_guid_fields(load_u64(bytes));
+            else
+                return load_u64(bytes);
+        }
+
+        static constexpr void store_upper(uint64_t x, std::span<ByteT, 8> bytes) {
+            if constexpr (Layout::mixed_endian)
+                store_u64(swap_guid_fields(x), bytes);
+            else
+                store_u64(x, bytes);
+        }
+
     public:
         static constexpr void load_from_bytes(uuid_u128& u, std::span<const ByteT> bytes) {
             if (auto fixed = try_fixed<16>(bytes)) {
-                u.upper(load_u64(fixed_subspan<0, 8>(*fixed)));
+                u.upper(load_upper(fixed_subspan<0, 8>(*fixed)));
                 u.lower(load_u64(fixed_subspan<8, 8>(*fixed)));
             } else {
                 throw std::invalid_argument("fquuid:load_from_bytes: input span size insufficient");
@@ -62,7 +84,7 @@ namespace fquuid::detail
 
         static constexpr size_t store_to_bytes(const uuid_u128& u, std::span<ByteT> bytes) {
             if (auto fixed = try_fixed<16>(bytes)) {
-                store_u64(u.upper(), fixed_subspan<0, 8>(*fixed));
+                store_upper(u.upper(), fixed_subspan<0, 8>(*fixed));
                 store_u64(u.lower(), fixed_subspan<8, 8>(*fixed));
                 return fixed->size();
             } else {
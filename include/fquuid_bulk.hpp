@@ -0,0 +1,184 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include "fquuid_uuid.hpp"
+#include "fquuid_simd.hpp"
+
+namespace fquuid::detail
+{
+    template <UuidLayout Layout>
+    class uuid_bulk_binary
+    {
+        // outputs larger than this bypass the cache with non-temporal stores
+        static constexpr size_t streaming_threshold = 4 * 1024 * 1024;
+
+        static_assert(sizeof(uuid) == 16);
+        static_assert(std::is_trivially_copyable_v<uuid>);
+
+#ifdef FQUUID_SIMD_SSE2
+        // Load: bytes -> uuid objects, !Load: uuid objects -> bytes.
+        // big_endian reverses both 64-bit words, which is the same in both directions.
+        // guid only reverses the lower word, the upper word is a 16-bit lane permutation.
+        template <bool Load>
+        static __m128i shuffle(__m128i x) {
+#ifdef FQUUID_SIMD_SSSE3
+            if constexpr (!Layout::mixed_endian)
+                return _mm_shuffle_epi8(x, _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0,
+                                                         15, 14, 13, 12, 11, 10, 9, 8));
+            else if constexpr (Load)
+                return _mm_shuffle_epi8(x, _mm_setr_epi8(6, 7, 4, 5, 0, 1, 2, 3,
+                                                         15, 14, 13, 12, 11, 10, 9, 8));
+            else
+                return _mm_shuffle_epi8(x, _mm_setr_epi8(4, 5, 6, 7, 2, 3, 0, 1,
+                                                         15, 14, 13, 12, 11, 10, 9, 8));
+#else
+            auto r = _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+            r = _mm_shufflehi_epi16(r, _MM_SHUFFLE(0, 1, 2, 3));
+            if constexpr (!Layout::mixed_endian)
+                return _mm_shufflelo_epi16(r, _MM_SHUFFLE(0, 1, 2, 3));
+
+            auto l = Load ? _mm_shufflelo_epi16(x, _MM_SHUFFLE(1, 0, 2, 3))
+                          : _mm_shufflelo_epi16(x, _MM_SHUFFLE(0, 1, 3, 2));
+            return _mm_castpd_si128(_mm_move_sd(_mm_castsi128_pd(r), _mm_castsi128_pd(l)));
+#endif
+        }
+
+#ifdef FQUUID_SIMD_AVX2
+        template <bool Load>
+        static __m256i shuffle(__m256i x) {
+            if constexpr (!Layout::mixed_endian)
+                return _mm256_shuffle_epi8(x, _mm256_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                               7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+            else if constexpr (Load)
+                return _mm256_shuffle_epi8(x, _mm256_setr_epi8(6, 7, 4, 5, 0, 1, 2, 3, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                               6, 7, 4, 5, 0, 1, 2, 3, 15, 14, 13, 12, 11, 10, 9, 8));
+            else
+                return _mm256_shuffle_epi8(x, _mm256_setr_epi8(4, 5, 6, 7, 2, 3, 0, 1, 15, 14, 13, 12, 11, 10, 9, 8,
+                                                               4, 5, 6, 7, 2, 3, 0, 1, 15, 14, 13, 12, 11, 10, 9, 8));
+        }
+#endif
+
+        template <bool Load>
+        static void shuffle_copy_stream(const std::byte* src, std::byte* dst, size_t count) {
+            auto p = reinterpret_cast<const __m128i*>(src);
+            auto q = reinterpret_cast<__m128i*>(dst);
+            for (size_t i = 0; i < count; i++)
+                _mm_stream_si128(q + i, shuffle<Load>(_mm_loadu_si128(p + i)));
+            _mm_sfence();
+        }
+
+        template <bool Load>
+        static void shuffle_copy(const std::byte* src, std::byte* dst, size_t count) {
+            auto p = reinterpret_cast<const __m128i*>(src);
+            auto q = reinterpret_cast<__m128i*>(dst);
+            size_t i = 0;
+#ifdef FQUUID_SIMD_AVX2
+            for (; i + 4 <= count; i += 4) {
+                auto x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                auto x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + 2));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i), shuffle<Load>(x0));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(q + i + 2), shuffle<Load>(x1));
+            }
+#endif
+            for (; i < count; i++)
+                _mm_storeu_si128(q + i, shuffle<Load>(_mm_loadu_si128(p + i)));
+        }
+#endif
+
+        template <bool Load>
+        static bool try_shuffle_copy(const std::byte* src, std::byte* dst, size_t count) {
+#ifdef FQUUID_SIMD_SSE2
+            if constexpr (std::endian::native == std::endian::little) {
+                if (count * 16 >= streaming_threshold && (reinterpret_cast<uintptr_t>(dst) & 15) == 0)
+                    shuffle_copy_stream<Load>(src, dst, count);
+                else
+                    shuffle_copy<Load>(src, dst, count);
+                return true;
+            }
+#endif
+            return false;
+        }
+
+    public:
+        template <ByteLike ByteT>
+        static constexpr size_t load_many(std::span<const ByteT> bytes, std::span<uuid> out) {
+            if (bytes.size() < out.size() * 16)
+                throw std::invalid_argument("fquuid:load_many: input span size insufficient");
+
+            if (!std::is_constant_evaluated()) {
+                if (try_shuffle_copy<true>(reinterpret_cast<const std::byte*>(bytes.data()),
+                                           reinterpret_cast<std::byte*>(out.data()), out.size()))
+                    return out.size();
+            }
+
+            for (size_t i = 0; i < out.size(); i++)
+                out[i] = uuid::from_bytes<Layout>(bytes.subspan(i * 16, 16));
+            return out.size();
+        }
+
+        template <ByteLike ByteT>
+        static constexpr size_t store_many(std::span<const uuid> in, std::span<ByteT> bytes) {
+            if (bytes.size() < in.size() * 16)
+                throw std::invalid_argument("fquuid:store_many: output span size insufficient");
+
+            if (!std::is_constant_evaluated()) {
+                if (try_shuffle_copy<false>(reinterpret_cast<const std::byte*>(in.data()),
+                                            reinterpret_cast<std::byte*>(bytes.data()), in.size()))
+                    return in.size() * 16;
+            }
+
+            for (size_t i = 0; i < in.size(); i++)
+                in[i].template write_bytes<Layout>(bytes.subspan(i * 16, 16));
+            return in.size() * 16;
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Loads out.size() UUIDs from consecutive 16-byte records in the given layout
+    template <UuidLayout Layout>
+    constexpr size_t load_many(std::span<const std::byte> bytes, std::span<uuid> out) {
+        return detail::uuid_bulk_binary<Layout>::load_many(bytes, out);
+    }
+
+    template <UuidLayout Layout>
+    constexpr size_t load_many(std::span<const uint8_t> bytes, std::span<uuid> out) {
+        return detail::uuid_bulk_binary<Layout>::load_many(bytes, out);
+    }
+
+    // Stores in.size() UUIDs as consecutive 16-byte records in the given layout, returns bytes written
+    template <UuidLayout Layout>
+    constexpr size_t store_many(std::span<const uuid> in, std::span<std::byte> bytes) {
+        return detail::uuid_bulk_binary<Layout>::store_many(in, bytes);
+    }
+
+    template <UuidLayout Layout>
+    constexpr size_t store_many(std::span<const uuid> in, std::span<uint8_t> bytes) {
+        return detail::uuid_bulk_binary<Layout>::store_many(in, bytes);
+    }
+
+    // Loads out.size() UUIDs from consecutive 16-byte big-endian records
+    constexpr size_t load_many(std::span<const std::byte> bytes, std::span<uuid> out) {
+        return load_many<layout::big_endian>(bytes, out);
+    }
+
+    constexpr size_t load_many(std::span<const uint8_t> bytes, std::span<uuid> out) {
+        return load_many<layout::big_endian>(bytes, out);
+    }
+
+    // Stores in.size() UUIDs as consecutive 16-byte big-endian records, returns bytes written
+    constexpr size_t store_many(std::span<const uuid> in, std::span<std::byte> bytes) {
+        return store_many<layout::big_endian>(in, bytes);
+    }
+
+    constexpr size_t store_many(std::span<const uuid> in, std::span<uint8_t> bytes) {
+        return store_many<layout::big_endian>(in, bytes);
+    }
+}
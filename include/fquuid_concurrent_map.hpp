@@ -0,0 +1,156 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+#include "fquuid_uuid.hpp"
+#include "fquuid_hash.hpp"
+#include "fquuid_flat_map.hpp"
+
+namespace fquuid
+{
+    // Hash map shared between threads, split into independently locked shards.
+    // Readers take a shared lock on one shard, writers an exclusive lock on one shard.
+    //
+    // Reclamation: no reference into the table ever escapes a lock.
+    // find() returns a copy, visit() / update() run the callback while the shard lock is held,
+    // so erasing or rehashing a shard never races with a reader and needs no epochs or hazard pointers.
+    // Store std::shared_ptr<const T> as the value when copies are expensive.
+    template <class T, class Hash = uuid_hash>
+    class uuid_concurrent_map
+    {
+        struct alignas(64) shard
+        {
+            mutable std::shared_mutex mutex;
+            uuid_flat_map<T, Hash> map;
+        };
+
+        std::unique_ptr<shard[]> shards_;
+        size_t shard_count_;
+        int shard_bits_;
+        [[no_unique_address]] Hash hash_;
+
+        static size_t default_shard_count() {
+            return std::bit_ceil(std::max<size_t>(16, std::thread::hardware_concurrency() * 4));
+        }
+
+        // shard by the top bits, the flat map in each shard indexes by the low bits
+        shard& shard_of(const uuid& key) const {
+            auto h = static_cast<size_t>(hash_(key));
+            return shards_[std::rotl(h, shard_bits_) & (shard_count_ - 1)];
+        }
+
+    public:
+        using key_type = uuid;
+        using mapped_type = T;
+        using hasher = Hash;
+
+        uuid_concurrent_map() : uuid_concurrent_map(default_shard_count()) {}
+
+        // shard_count is rounded up to a power of two
+        explicit uuid_concurrent_map(size_t shard_count, const Hash& hash = Hash())
+            : shards_(std::make_unique<shard[]>(std::bit_ceil(std::max<size_t>(shard_count, 1)))),
+              shard_count_(std::bit_ceil(std::max<size_t>(shard_count, 1))),
+              shard_bits_(std::countr_zero(shard_count_)),
+              hash_(hash) {}
+
+        uuid_concurrent_map(const uuid_concurrent_map&) = delete;
+        uuid_concurrent_map& operator =(const uuid_concurrent_map&) = delete;
+
+        size_t shard_count() const noexcept { return shard_count_; }
+
+        std::optional<T> find(const uuid& key) const {
+            auto& s = shard_of(key);
+            std::shared_lock lock(s.mutex);
+            auto it = s.map.find(key);
+            if (it == s.map.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        bool contains(const uuid& key) const {
+            auto& s = shard_of(key);
+            std::shared_lock lock(s.mutex);
+            return s.map.contains(key);
+        }
+
+        // fn(const T&) under the shard's shared lock, returns whether the key was found
+        template <class Fn>
+        bool visit(const uuid& key, Fn&& fn) const {
+            auto& s = shard_of(key);
+            std::shared_lock lock(s.mutex);
+            auto it = s.map.find(key);
+            if (it == s.map.end())
+                return false;
+            fn(std::as_const(it->second));
+            return true;
+        }
+
+        // fn(T&) under the shard's exclusive lock, returns whether the key was found
+        template <class Fn>
+        bool update(const uuid& key, Fn&& fn) {
+            auto& s = shard_of(key);
+            std::unique_lock lock(s.mutex);
+            auto it = s.map.find(key);
+            if (it == s.map.end())
+                return false;
+            fn(it->second);
+            return true;
+        }
+
+        // returns true when inserted, false when the key already existed
+        template <class... Args>
+        bool try_emplace(const uuid& key, Args&&... args) {
+            auto& s = shard_of(key);
+            std::unique_lock lock(s.mutex);
+            return s.map.try_emplace(key, std::forward<Args>(args)...).second;
+        }
+
+        template <class M>
+        bool insert_or_assign(const uuid& key, M&& m) {
+            auto& s = shard_of(key);
+            std::unique_lock lock(s.mutex);
+            return s.map.insert_or_assign(key, std::forward<M>(m)).second;
+        }
+
+        bool erase(const uuid& key) {
+            auto& s = shard_of(key);
+            std::unique_lock lock(s.mutex);
+            return s.map.erase(key) != 0;
+        }
+
+        // sum over shards, exact only while no writer runs
+        size_t size() const {
+            size_t n = 0;
+            for (size_t i = 0; i < shard_count_; i++) {
+                std::shared_lock lock(shards_[i].mutex);
+                n += shards_[i].map.size();
+            }
+            return n;
+        }
+
+        void clear() {
+            for (size_t i = 0; i < shard_count_; i++) {
+                std::unique_lock lock(shards_[i].mutex);
+                shards_[i].map.clear();
+            }
+        }
+
+        // fn(const uuid&, const T&) shard by shard, each under its shared lock
+        template <class Fn>
+        void for_each(Fn&& fn) const {
+            for (size_t i = 0; i < shard_count_; i++) {
+                std::shared_lock lock(shards_[i].mutex);
+                for (auto& [k, v] : shards_[i].map)
+                    fn(k, v);
+            }
+        }
+    };
+}
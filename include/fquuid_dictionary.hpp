@@ -0,0 +1,331 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_hash.hpp"
+#include "fquuid_flat_map.hpp"
+
+namespace fquuid
+{
+    // Append-only interner assigning dense ids 0, 1, 2, ... to uuids in first-seen order.
+    // uuid -> id goes through a flat map, id -> uuid indexes a contiguous vector,
+    // so joins and group-bys can run on Id and resolve back to uuid only when emitting.
+    template <std::unsigned_integral Id = uint32_t, class Hash = uuid_hash>
+    class uuid_basic_dictionary
+    {
+        static constexpr size_t batch = 256;
+
+        uuid_flat_map<Id, Hash> ids_;
+        std::vector<uuid> uuids_;
+
+    public:
+        using id_type = Id;
+        using hasher = Hash;
+
+        // returned by find_many for absent keys, never assigned
+        static constexpr Id npos = std::numeric_limits<Id>::max();
+
+        uuid_basic_dictionary() = default;
+        explicit uuid_basic_dictionary(const Hash& hash) : ids_(0, hash) {}
+
+        size_t size() const noexcept { return uuids_.size(); }
+        bool empty() const noexcept { return uuids_.empty(); }
+
+        void reserve(size_t n) {
+            ids_.reserve(n);
+            uuids_.reserve(n);
+        }
+
+        void clear() noexcept {
+            ids_.clear();
+            uuids_.clear();
+        }
+
+        // id of key, assigning the next id when the key is new
+        Id intern(const uuid& key) {
+            auto [it, inserted] = ids_.try_emplace(key, static_cast<Id>(uuids_.size()));
+            if (inserted) {
+                // a key left mapped without its uuid would share its id with the next new key
+                try {
+                    if (uuids_.size() == npos)
+                        throw std::length_error("fquuid:uuid_dictionary: id space exhausted");
+                    uuids_.push_back(key);
+                }
+                catch (...) {
+                    ids_.erase(key);
+                    throw;
+                }
+            }
+            return it->second;
+        }
+
+        // out[i] = intern(keys[i]), returns the number of new keys.
+        // Existing keys are looked up in prefetched batches first, so only new keys pay for an insert.
+        size_t intern_many(std::span<const uuid> keys, std::span<Id> out) {
+            if (out.size() < keys.size())
+                throw std::invalid_argument("fquuid:intern_many: output span size insufficient");
+
+            auto added = uuids_.size();
+            std::array<const Id*, batch> found;
+            std::array<Id, batch> known;
+            for (size_t b = 0; b < keys.size(); b += batch) {
+                auto chunk = keys.subspan(b, std::min(batch, keys.size() - b));
+                std::as_const(ids_).find_many(chunk, std::span<const Id*>(found));
+                // copied out before interning: an insert may rehash and free the slots found points into
+                for (size_t i = 0; i < chunk.size(); i++)
+                    known[i] = found[i] ? *found[i] : npos;
+                for (size_t i = 0; i < chunk.size(); i++)
+                    out[b + i] = known[i] != npos ? known[i] : intern(chunk[i]);
+            }
+            return uuids_.size() - added;
+        }
+
+        std::optional<Id> find(const uuid& key) const noexcept {
+            auto it = ids_.find(key);
+            if (it == ids_.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        bool contains(const uuid& key) const noexcept {
+            return ids_.contains(key);
+        }
+
+        // out[i]: id of keys[i] or npos, returns the number found
+        size_t find_many(std::span<const uuid> keys, std::span<Id> out) const {
+            if (out.size() < keys.size())
+                throw std::invalid_argument("fquuid:find_many: output span size insufficient");
+
+            size_t n = 0;
+            std::array<const Id*, batch> found;
+            for (size_t b = 0; b < keys.size(); b += batch) {
+                auto chunk = keys.subspan(b, std::min(batch, keys.size() - b));
+                n += ids_.find_many(chunk, std::span<const Id*>(found));
+                for (size_t i = 0; i < chunk.size(); i++)
+                    out[b + i] = found[i] ? *found[i] : npos;
+            }
+            return n;
+        }
+
+        const uuid& operator [](Id id) const noexcept {
+            return uuids_[id];
+        }
+
+        const uuid& at(Id id) const {
+            if (id >= uuids_.size())
+                throw std::out_of_range("fquuid:uuid_dictionary: id not found");
+            return uuids_[id];
+        }
+
+        // out[i] = at(ids[i])
+        void resolve_many(std::span<const Id> ids, std::span<uuid> out) const {
+            if (out.size() < ids.size())
+                throw std::invalid_argument("fquuid:resolve_many: output span size insufficient");
+            for (size_t i = 0; i < ids.size(); i++)
+                out[i] = at(ids[i]);
+        }
+
+        // every interned uuid, indexed by id
+        std::span<const uuid> uuids() const noexcept {
+            return uuids_;
+        }
+    };
+
+    using uuid_dictionary = uuid_basic_dictionary<uint32_t>;
+    using uuid_dictionary64 = uuid_basic_dictionary<uint64_t>;
+
+    // uuid_basic_dictionary shared between threads.
+    //
+    // uuid -> id is sharded like uuid_concurrent_map. id -> uuid is a segmented array whose segments
+    // double in size and are never moved, so operator[] reads without a lock while other threads intern.
+    // An id is published to other threads through the shard lock, after its uuid was stored,
+    // so any id obtained from intern() or find() resolves.
+    template <std::unsigned_integral Id = uint32_t, class Hash = uuid_hash>
+    class uuid_basic_concurrent_dictionary
+    {
+        struct alignas(64) shard
+        {
+            mutable std::shared_mutex mutex;
+            uuid_flat_map<Id, Hash> map;
+        };
+
+        static constexpr Id max_id = std::numeric_limits<Id>::max();
+        static constexpr int first_segment_bits = 10;
+        static constexpr int segment_count = std::numeric_limits<Id>::digits - first_segment_bits + 1;
+
+        std::unique_ptr<shard[]> shards_;
+        size_t shard_count_;
+        int shard_bits_;
+        [[no_unique_address]] Hash hash_;
+
+        std::atomic<uint64_t> next_ = 0;
+        // segment s holds ids [2^(s + 10) - 2^10, 2^(s + 11) - 2^10)
+        std::array<std::atomic<uuid*>, segment_count> segments_ = {};
+
+        static size_t default_shard_count() {
+            return std::bit_ceil(std::max<size_t>(16, std::thread::hardware_concurrency() * 4));
+        }
+
+        shard& shard_of(const uuid& key) const {
+            auto h = static_cast<size_t>(hash_(key));
+            return shards_[std::rotl(h, shard_bits_) & (shard_count_ - 1)];
+        }
+
+        static std::pair<int, size_t> locate(uint64_t id) noexcept {
+            auto i = id + (uint64_t{1} << first_segment_bits);
+            auto s = std::bit_width(i) - 1 - first_segment_bits;
+            return { s, static_cast<size_t>(i - (uint64_t{1} << (s + first_segment_bits))) };
+        }
+
+        uuid* segment(int s) {
+            auto p = segments_[s].load(std::memory_order_acquire);
+            if (p)
+                return p;
+            auto fresh = new uuid[size_t{1} << (s + first_segment_bits)];
+            if (segments_[s].compare_exchange_strong(p, fresh, std::memory_order_acq_rel))
+                return fresh;
+            delete[] fresh;
+            return p;
+        }
+
+        std::pair<Id, bool> intern_impl(const uuid& key) {
+            auto& s = shard_of(key);
+            {
+                std::shared_lock lock(s.mutex);
+                auto it = s.map.find(key);
+                if (it != s.map.end())
+                    return { it->second, false };
+            }
+
+            std::unique_lock lock(s.mutex);
+            auto it = s.map.find(key);
+            if (it != s.map.end())
+                return { it->second, false };
+
+            // everything that may throw happens before the id is taken, so no id is ever lost
+            s.map.reserve(s.map.size() + 1);
+            auto id = next_.load(std::memory_order_relaxed);
+            uuid* p;
+            for (;;) {
+                if (id >= max_id)
+                    throw std::length_error("fquuid:uuid_concurrent_dictionary: id space exhausted");
+                p = segment(locate(id).first);
+                if (next_.compare_exchange_weak(id, id + 1, std::memory_order_relaxed))
+                    break;
+            }
+            p[locate(id).second] = key;
+            s.map.try_emplace(key, static_cast<Id>(id));
+            return { static_cast<Id>(id), true };
+        }
+
+    public:
+        using id_type = Id;
+        using hasher = Hash;
+
+        static constexpr Id npos = max_id;
+
+        uuid_basic_concurrent_dictionary() : uuid_basic_concurrent_dictionary(default_shard_count()) {}
+
+        // shard_count is rounded up to a power of two
+        explicit uuid_basic_concurrent_dictionary(size_t shard_count, const Hash& hash = Hash())
+            : shards_(std::make_unique<shard[]>(std::bit_ceil(std::max<size_t>(shard_count, 1)))),
+              shard_count_(std::bit_ceil(std::max<size_t>(shard_count, 1))),
+              shard_bits_(std::countr_zero(shard_count_)),
+              hash_(hash) {}
+
+        uuid_basic_concurrent_dictionary(const uuid_basic_concurrent_dictionary&) = delete;
+        uuid_basic_concurrent_dictionary& operator =(const uuid_basic_concurrent_dictionary&) = delete;
+
+        ~uuid_basic_concurrent_dictionary() {
+            for (auto& s : segments_)
+                delete[] s.load(std::memory_order_relaxed);
+        }
+
+        size_t shard_count() const noexcept { return shard_count_; }
+
+        // ids handed out so far
+        size_t size() const noexcept {
+            return static_cast<size_t>(std::min<uint64_t>(next_.load(std::memory_order_acquire), npos));
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+
+        Id intern(const uuid& key) {
+            return intern_impl(key).first;
+        }
+
+        // out[i] = intern(keys[i]), returns the number of keys this call added
+        size_t intern_many(std::span<const uuid> keys, std::span<Id> out) {
+            if (out.size() < keys.size())
+                throw std::invalid_argument("fquuid:intern_many: output span size insufficient");
+
+            size_t added = 0;
+            for (size_t i = 0; i < keys.size(); i++) {
+                auto [id, inserted] = intern_impl(keys[i]);
+                out[i] = id;
+                added += inserted;
+            }
+            return added;
+        }
+
+        std::optional<Id> find(const uuid& key) const {
+            auto& s = shard_of(key);
+            std::shared_lock lock(s.mutex);
+            auto it = s.map.find(key);
+            if (it == s.map.end())
+                return std::nullopt;
+            return it->second;
+        }
+
+        bool contains(const uuid& key) const {
+            auto& s = shard_of(key);
+            std::shared_lock lock(s.mutex);
+            return s.map.contains(key);
+        }
+
+        // id must come from intern() or find()
+        const uuid& operator [](Id id) const noexcept {
+            auto [seg, offset] = locate(id);
+            return segments_[seg].load(std::memory_order_acquire)[offset];
+        }
+
+        // Throws for ids not handed out yet. As with operator[], the id should come from intern()
+        // or find(): an id another thread is still interning may read a partly written uuid.
+        const uuid& at(Id id) const {
+            if (id >= size())
+                throw std::out_of_range("fquuid:uuid_concurrent_dictionary: id not found");
+            auto [seg, offset] = locate(id);
+            auto p = segments_[seg].load(std::memory_order_acquire);
+            if (!p)
+                throw std::out_of_range("fquuid:uuid_concurrent_dictionary: id not found");
+            return p[offset];
+        }
+
+        void resolve_many(std::span<const Id> ids, std::span<uuid> out) const {
+            if (out.size() < ids.size())
+                throw std::invalid_argument("fquuid:resolve_many: output span size insufficient");
+            for (size_t i = 0; i < ids.size(); i++)
+                out[i] = at(ids[i]);
+        }
+    };
+
+    using uuid_concurrent_dictionary = uuid_basic_concurrent_dictionary<uint32_t>;
+    using uuid_concurrent_dictionary64 = uuid_basic_concurrent_dictionary<uint64_t>;
+}
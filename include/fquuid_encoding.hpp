@@ -0,0 +1,441 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include "fquuid_types.hpp"
+#include "fquuid_spanner.hpp"
+#include "fquuid_simd.hpp"
+
+namespace fquuid::detail
+{
+#ifdef FQUUID_SIMD_SSE2
+    // [0-63] -> [A-Za-z0-9-_]
+    inline __m128i sse2_u6_to_base64url(__m128i v) {
+        auto ge26 = _mm_cmpgt_epi8(v, _mm_set1_epi8(25));
+        auto ge52 = _mm_cmpgt_epi8(v, _mm_set1_epi8(51));
+        auto eq62 = _mm_cmpeq_epi8(v, _mm_set1_epi8(62));
+        auto eq63 = _mm_cmpeq_epi8(v, _mm_set1_epi8(63));
+
+        auto offset = _mm_set1_epi8('A');
+        offset = _mm_add_epi8(offset, _mm_and_si128(ge26, _mm_set1_epi8('a' - 26 - 'A')));
+        offset = _mm_add_epi8(offset, _mm_and_si128(ge52, _mm_set1_epi8(('0' - 52) - ('a' - 26))));
+        offset = _mm_add_epi8(offset, _mm_and_si128(eq62, _mm_set1_epi8(('-' - 62) - ('0' - 52))));
+        offset = _mm_add_epi8(offset, _mm_and_si128(eq63, _mm_set1_epi8(('_' - 63) - ('0' - 52))));
+        return _mm_add_epi8(v, offset);
+    }
+
+    // [A-Za-z0-9-_] -> [0-63], lanes of other characters are cleared in valid
+    inline __m128i sse2_base64url_to_u6(__m128i c, __m128i& valid) {
+        auto upper = sse2_in_range(c, 'A', 'Z');
+        auto lower = sse2_in_range(c, 'a', 'z');
+        auto digit = sse2_in_range(c, '0', '9');
+        auto dash = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+        auto underscore = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+
+        valid = _mm_or_si128(_mm_or_si128(upper, lower),
+                             _mm_or_si128(digit, _mm_or_si128(dash, underscore)));
+
+        auto offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+        offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        offset = _mm_or_si128(offset, _mm_and_si128(dash, _mm_set1_epi8(62 - '-')));
+        offset = _mm_or_si128(offset, _mm_and_si128(underscore, _mm_set1_epi8(63 - '_')));
+        return _mm_add_epi8(c, offset);
+    }
+
+    // [0-31] -> Crockford [0-9A-HJKMNP-TV-Z]
+    inline __m128i sse2_u5_to_base32(__m128i v) {
+        auto ge10 = _mm_cmpgt_epi8(v, _mm_set1_epi8(9));
+        auto ge18 = _mm_cmpgt_epi8(v, _mm_set1_epi8(17));
+        auto ge20 = _mm_cmpgt_epi8(v, _mm_set1_epi8(19));
+        auto ge22 = _mm_cmpgt_epi8(v, _mm_set1_epi8(21));
+        auto ge27 = _mm_cmpgt_epi8(v, _mm_set1_epi8(26));
+
+        // mask lanes are -1, so subtracting them skips the letters I, L, O and U
+        auto offset = _mm_add_epi8(_mm_set1_epi8('0'), _mm_and_si128(ge10, _mm_set1_epi8('A' - 10 - '0')));
+        offset = _mm_sub_epi8(offset, _mm_add_epi8(ge18, ge20));
+        offset = _mm_sub_epi8(offset, _mm_add_epi8(ge22, ge27));
+        return _mm_add_epi8(v, offset);
+    }
+#endif
+
+    template <class CharT>
+    constexpr std::span<const CharT> trim_terminator(std::span<const CharT> s) {
+        if (s.size() >= 1 && s.back() == 0)
+            return s.first(s.size() - 1);
+        return s;
+    }
+
+    template <size_t Length, class CharT, class WriteFn>
+    constexpr size_t write_fixed(std::span<CharT> s, string_terminator term, WriteFn fn) {
+        if (term == string_terminator::null) {
+            if (auto fixed = try_fixed<Length + 1>(s)) {
+                fn(fixed_first<Length>(*fixed));
+                fixed_back(*fixed) = 0;
+                return fixed->size();
+            }
+        } else {
+            if (auto fixed = try_fixed<Length>(s)) {
+                fn(*fixed);
+                return fixed->size();
+            }
+        }
+        throw std::invalid_argument("fquuid:write: output span size insufficient");
+    }
+
+    template <class CharT>
+    constexpr void store_ascii(std::span<const char> src, std::span<CharT> dst) {
+        std::copy_n(src.begin(), dst.size(), dst.begin());
+    }
+
+    template <size_t Size>
+    constexpr auto make_decode_table(std::string_view alphabet) {
+        std::array<int8_t, 256> a;
+        a.fill(-1);
+        for (size_t i = 0; i < Size; i++)
+            a[static_cast<uint8_t>(alphabet[i])] = i;
+        return a;
+    }
+
+    // ok = 0x00 - 0x7f, error = 0xffff'ffff'ffff'ffff
+    template <class CharT>
+    constexpr uint64_t decode_char(const std::array<int8_t, 256>& table, CharT c) {
+        if constexpr (sizeof(c) > 1) {
+            if (static_cast<size_t>(c) > 0xff)
+                return -1;
+        }
+        return table[static_cast<size_t>(c) & 0xff];
+    }
+
+    // RFC 4648 base64url without padding (22 characters)
+    template <class CharT>
+    class uuid_basic_base64url
+    {
+    public:
+        static constexpr size_t length = 22;
+
+    private:
+        static constexpr std::string_view alphabet =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+        static constexpr auto decode_table = make_decode_table<64>(alphabet);
+
+        static constexpr std::array<uint8_t, 32> split_u6(const uuid_u128& u) {
+            std::array<uint8_t, 32> v {};
+            for (size_t i = 0; i < 10; i++)
+                v[i] = (u.upper() >> (58 - 6 * i)) & 0x3f;
+            v[10] = ((u.upper() & 0x0f) << 2) | (u.lower() >> 62);
+            for (size_t i = 0; i < 10; i++)
+                v[11 + i] = (u.lower() >> (56 - 6 * i)) & 0x3f;
+            v[21] = (u.lower() & 0x03) << 4;
+            return v;
+        }
+
+        static constexpr void join_u6(uuid_u128& u, const std::array<uint8_t, 32>& v) {
+            if (v[21] & 0x0f)
+                throw std::invalid_argument("fquuid:parse: non-canonical base64url string");
+
+            uint64_t upper = 0;
+            for (size_t i = 0; i < 10; i++)
+                upper |= static_cast<uint64_t>(v[i]) << (58 - 6 * i);
+            uint64_t lower = 0;
+            for (size_t i = 0; i < 10; i++)
+                lower |= static_cast<uint64_t>(v[11 + i]) << (56 - 6 * i);
+
+            u.upper(upper | v[10] >> 2);
+            u.lower(lower | static_cast<uint64_t>(v[10]) << 62 | v[21] >> 4);
+        }
+
+        static constexpr void write_chars(const uuid_u128& u, std::span<CharT, length> s) {
+            auto v = split_u6(u);
+#ifdef FQUUID_SIMD_SSE2
+            if (!std::is_constant_evaluated()) {
+                alignas(16) std::array<char, 32> buf;
+                auto p = reinterpret_cast<const __m128i*>(v.data());
+                auto q = reinterpret_cast<__m128i*>(buf.data());
+                _mm_store_si128(q, sse2_u6_to_base64url(_mm_loadu_si128(p)));
+                _mm_store_si128(q + 1, sse2_u6_to_base64url(_mm_loadu_si128(p + 1)));
+                store_ascii<CharT>(buf, s);
+                return;
+            }
+#endif
+            for (size_t i = 0; i < length; i++)
+                s[i] = alphabet[v[i]];
+        }
+
+        static constexpr void parse_chars(uuid_u128& u, std::span<const CharT, length> s) {
+            std::array<uint8_t, 32> v {};
+#ifdef FQUUID_SIMD_SSE2
+            if constexpr (sizeof(CharT) == 1) {
+                if (!std::is_constant_evaluated()) {
+                    alignas(16) std::array<char, 32> buf;
+                    buf.fill('A');
+                    std::memcpy(buf.data(), s.data(), length);
+
+                    __m128i valid0, valid1;
+                    auto p = reinterpret_cast<const __m128i*>(buf.data());
+                    auto q = reinterpret_cast<__m128i*>(v.data());
+                    _mm_storeu_si128(q, sse2_base64url_to_u6(_mm_load_si128(p), valid0));
+                    _mm_storeu_si128(q + 1, sse2_base64url_to_u6(_mm_load_si128(p + 1), valid1));
+
+                    if (_mm_movemask_epi8(_mm_and_si128(valid0, valid1)) != 0xffff)
+                        throw std::invalid_argument("fquuid:parse: invalid base64url character");
+
+                    join_u6(u, v);
+                    return;
+                }
+            }
+#endif
+            uint64_t error = 0;
+            for (size_t i = 0; i < length; i++) {
+                auto x = decode_char(decode_table, s[i]);
+                error |= x;
+                v[i] = x;
+            }
+            if (error >> 6)
+                throw std::invalid_argument("fquuid:parse: invalid base64url character");
+
+            join_u6(u, v);
+        }
+
+    public:
+        static constexpr void parse(uuid_u128& u, std::span<const CharT> s) {
+            if (auto fixed = try_fixed_equal<length>(trim_terminator(s)))
+                parse_chars(u, *fixed);
+            else
+                throw std::invalid_argument("fquuid:parse: invalid base64url string length");
+        }
+
+        static constexpr void parse(uuid_u128& u, const CharT* s) {
+            if (s == nullptr)
+                throw std::invalid_argument("fquuid:parse: argument is nullptr");
+
+            parse(u, std::basic_string_view<CharT>(s));
+        }
+
+        static constexpr size_t write(const uuid_u128& u, std::span<CharT> s, string_terminator term) {
+            return write_fixed<length>(s, term, [&](std::span<CharT, length> fixed) {
+                write_chars(u, fixed);
+            });
+        }
+    };
+
+    // Crockford base32 (26 characters), same order as the binary value
+    template <class CharT>
+    class uuid_basic_base32
+    {
+    public:
+        static constexpr size_t length = 26;
+
+    private:
+        static constexpr std::string_view alphabet = "0123456789ABCDEFGHJKMNPQRSTVWXYZ";
+
+        static constexpr auto decode_table = [] {
+            auto a = make_decode_table<32>(alphabet);
+            for (size_t i = 10; i < 32; i++)
+                a[alphabet[i] - 'A' + 'a'] = i;
+            a['I'] = a['i'] = a['L'] = a['l'] = 1;
+            a['O'] = a['o'] = 0;
+            return a;
+        }();
+
+        static constexpr std::array<uint8_t, 32> split_u5(const uuid_u128& u) {
+            std::array<uint8_t, 32> v {};
+            v[0] = u.upper() >> 61;
+            for (size_t i = 0; i < 12; i++)
+                v[1 + i] = (u.upper() >> (56 - 5 * i)) & 0x1f;
+            v[13] = ((u.upper() & 0x01) << 4) | (u.lower() >> 60);
+            for (size_t i = 0; i < 12; i++)
+                v[14 + i] = (u.lower() >> (55 - 5 * i)) & 0x1f;
+            return v;
+        }
+
+        static constexpr void join_u5(uuid_u128& u, const std::array<uint8_t, 32>& v) {
+            if (v[0] > 7)
+                throw std::invalid_argument("fquuid:parse: base32 value out of range");
+
+            uint64_t upper = static_cast<uint64_t>(v[0]) << 61;
+            for (size_t i = 0; i < 12; i++)
+                upper |= static_cast<uint64_t>(v[1 + i]) << (56 - 5 * i);
+            uint64_t lower = static_cast<uint64_t>(v[13]) << 60;
+            for (size_t i = 0; i < 12; i++)
+                lower |= static_cast<uint64_t>(v[14 + i]) << (55 - 5 * i);
+
+            u.upper(upper | v[13] >> 4);
+            u.lower(lower);
+        }
+
+        static constexpr void write_chars(const uuid_u128& u, std::span<CharT, length> s) {
+            auto v = split_u5(u);
+#ifdef FQUUID_SIMD_SSE2
+            if (!std::is_constant_evaluated()) {
+                alignas(16) std::array<char, 32> buf;
+                auto p = reinterpret_cast<const __m128i*>(v.data());
+                auto q = reinterpret_cast<__m128i*>(buf.data());
+                _mm_store_si128(q, sse2_u5_to_base32(_mm_loadu_si128(p)));
+                _mm_store_si128(q + 1, sse2_u5_to_base32(_mm_loadu_si128(p + 1)));
+                store_ascii<CharT>(buf, s);
+                return;
+            }
+#endif
+            for (size_t i = 0; i < length; i++)
+                s[i] = alphabet[v[i]];
+        }
+
+        static constexpr void parse_chars(uuid_u128& u, std::span<const CharT, length> s) {
+            std::array<uint8_t, 32> v {};
+            uint64_t error = 0;
+            for (size_t i = 0; i < length; i++) {
+                auto x = decode_char(decode_table, s[i]);
+                error |= x;
+                v[i] = x;
+            }
+            if (error >> 5)
+                throw std::invalid_argument("fquuid:parse: invalid base32 character");
+
+            join_u5(u, v);
+        }
+
+    public:
+        static constexpr void parse(uuid_u128& u, std::span<const CharT> s) {
+            if (auto fixed = try_fixed_equal<length>(trim_terminator(s)))
+                parse_chars(u, *fixed);
+            else
+                throw std::invalid_argument("fquuid:parse: invalid base32 string length");
+        }
+
+        static constexpr void parse(uuid_u128& u, const CharT* s) {
+            if (s == nullptr)
+                throw std::invalid_argument("fquuid:parse: argument is nullptr");
+
+            parse(u, std::basic_string_view<CharT>(s));
+        }
+
+        static constexpr size_t write(const uuid_u128& u, std::span<CharT> s, string_terminator term) {
+            return write_fixed<length>(s, term, [&](std::span<CharT, length> fixed) {
+                write_chars(u, fixed);
+            });
+        }
+    };
+
+    // Bitcoin alphabet base58, zero padded to 22 characters so that
+    // the string order matches the binary order
+    template <class CharT>
+    class uuid_basic_base58
+    {
+    public:
+        static constexpr size_t length = 22;
+
+    private:
+        static constexpr std::string_view alphabet =
+            "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+        static constexpr auto decode_table = make_decode_table<58>(alphabet);
+
+        // 58^5 < 2^32
+        static constexpr uint64_t base58_pow5 = 58ull * 58 * 58 * 58 * 58;
+
+        static constexpr void write_chars(const uuid_u128& u, std::span<CharT, length> s) {
+            // 32-bit limbs, most significant first
+            std::array<uint64_t, 4> limbs {
+                u.upper() >> 32, u.upper() & 0xffff'ffff,
+                u.lower() >> 32, u.lower() & 0xffff'ffff,
+            };
+
+            size_t pos = length;
+            for (int chunk = 0; chunk < 4; chunk++) {
+                uint64_t r = 0;
+                for (auto& limb : limbs) {
+                    auto x = (r << 32) | limb;
+                    limb = x / base58_pow5;
+                    r = x % base58_pow5;
+                }
+                for (int i = 0; i < 5; i++) {
+                    s[--pos] = alphabet[r % 58];
+                    r /= 58;
+                }
+            }
+
+            // 2^128 / 58^20 < 58^2
+            fixed_at<1>(s) = alphabet[limbs[3] % 58];
+            fixed_at<0>(s) = alphabet[limbs[3] / 58];
+        }
+
+        static constexpr void parse_chars(uuid_u128& u, std::span<const CharT, length> s) {
+            std::array<uint64_t, 4> limbs {};
+
+            for (auto c : s) {
+                auto carry = decode_char(decode_table, c);
+                if (carry >> 6)
+                    throw std::invalid_argument("fquuid:parse: invalid base58 character");
+
+                for (size_t i = limbs.size(); i-- > 0; ) {
+                    auto x = limbs[i] * 58 + carry;
+                    limbs[i] = x & 0xffff'ffff;
+                    carry = x >> 32;
+                }
+                if (carry)
+                    throw std::invalid_argument("fquuid:parse: base58 value out of range");
+            }
+
+            u.upper(limbs[0] << 32 | limbs[1]);
+            u.lower(limbs[2] << 32 | limbs[3]);
+        }
+
+    public:
+        static constexpr void parse(uuid_u128& u, std::span<const CharT> s) {
+            if (auto fixed = try_fixed_equal<length>(trim_terminator(s)))
+                parse_chars(u, *fixed);
+            else
+                throw std::invalid_argument("fquuid:parse: invalid base58 string length");
+        }
+
+        static constexpr void parse(uuid_u128& u, const CharT* s) {
+            if (s == nullptr)
+                throw std::invalid_argument("fquuid:parse: argument is nullptr");
+
+            parse(u, std::basic_string_view<CharT>(s));
+        }
+
+        static constexpr size_t write(const uuid_u128& u, std::span<CharT> s, string_terminator term) {
+            return write_fixed<length>(s, term, [&](std::span<CharT, length> fixed) {
+                write_chars(u, fixed);
+            });
+        }
+    };
+}
+
+namespace fquuid::format
+{
+    struct base64url
+    {
+        static constexpr size_t length = detail::uuid_basic_base64url<char>::length;
+
+        template <class CharT>
+        using codec = detail::uuid_basic_base64url<CharT>;
+    };
+
+    struct base32
+    {
+        static constexpr size_t length = detail::uuid_basic_base32<char>::length;
+
+        template <class CharT>
+        using codec = detail::uuid_basic_base32<CharT>;
+    };
+
+    struct base58
+    {
+        static constexpr size_t length = detail::uuid_basic_base58<char>::length;
+
+        template <class CharT>
+        using codec = detail::uuid_basic_base58<CharT>;
+    };
+}
@@ -0,0 +1,506 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_hash.hpp"
+#include "fquuid_simd.hpp"
+
+// Approximate membership filters: no false negatives, a tunable false positive rate.
+//
+// Hash selects how key bits become the filter hash, as for the hash containers:
+// uuid_hash mixes every bit (v7 and anything else), uuid_trusted_v4_hash uses the random bits
+// of v4 keys directly. Serialized filters must be read back with the same Hash, so
+// uuid_seeded_hash (per-process seed by default) needs an explicit seed.
+
+namespace fquuid::detail
+{
+    struct uuid_filter_format
+    {
+        static constexpr size_t magic_size = 8;
+
+        static void write_magic(std::byte* p, const char (&magic)[magic_size + 1]) noexcept {
+            for (size_t i = 0; i < magic_size; i++)
+                p[i] = static_cast<std::byte>(magic[i]);
+        }
+
+        static bool check_magic(std::span<const std::byte> bytes, const char (&magic)[magic_size + 1]) noexcept {
+            if (bytes.size() < magic_size)
+                return false;
+            for (size_t i = 0; i < magic_size; i++) {
+                if (bytes[i] != static_cast<std::byte>(magic[i]))
+                    return false;
+            }
+            return true;
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Split block Bloom filter: a key sets one bit in each of the 8 words of one 32-byte block,
+    // so an insert or a lookup touches a single cache line.
+    // The upper 32 hash bits pick the block, the lower 32 bits make the 8 bit positions.
+    template <class Hash = uuid_hash>
+    class uuid_basic_bloom_filter
+    {
+        struct alignas(32) block
+        {
+            uint32_t w[8];
+        };
+
+        static constexpr uint32_t salt[8] = {
+            0x47b6'137b, 0x4497'4d91, 0x8824'ad5b, 0xa2b7'289d,
+            0x7054'95c7, 0x2df1'424b, 0x9efc'4947, 0x5c6b'fb31,
+        };
+
+        // "FQUUIDB1", block count, blocks (little-endian words)
+        static constexpr char magic[] = "FQUUIDB1";
+        static constexpr size_t header_size = 16;
+
+        static constexpr size_t batch_size = 16;
+
+        std::vector<block> blocks_;
+        [[no_unique_address]] Hash hash_;
+
+        uint64_t hash(const uuid& key) const noexcept {
+            return static_cast<uint64_t>(hash_(key));
+        }
+
+        size_t block_index(uint64_t h) const noexcept {
+            return static_cast<size_t>(((h >> 32) * blocks_.size()) >> 32);
+        }
+
+        static bool test(const block& b, uint64_t h) noexcept {
+#ifdef FQUUID_SIMD_AVX2
+            auto bits = _mm256_sllv_epi32(_mm256_set1_epi32(1),
+                _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(h)),
+                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(salt))), 27));
+            return _mm256_testc_si256(_mm256_load_si256(reinterpret_cast<const __m256i*>(b.w)), bits);
+#else
+            bool r = true;
+            for (int i = 0; i < 8; i++)
+                r &= (b.w[i] >> ((static_cast<uint32_t>(h) * salt[i]) >> 27)) & 1;
+            return r;
+#endif
+        }
+
+        explicit uuid_basic_bloom_filter(std::vector<block> blocks, const Hash& hash)
+            : blocks_(std::move(blocks)), hash_(hash) {}
+
+    public:
+        // bits_per_key = 12 gives about 0.5 % false positives at the expected key count
+        explicit uuid_basic_bloom_filter(size_t expected_keys, double bits_per_key = 12, const Hash& hash = Hash())
+            : blocks_(std::max<size_t>(1, static_cast<size_t>(std::ceil(static_cast<double>(expected_keys) * bits_per_key / 256))), block{}),
+              hash_(hash) {
+            if (blocks_.size() > (size_t{1} << 32))
+                throw std::invalid_argument("fquuid:uuid_bloom_filter: too many blocks");
+        }
+
+        size_t size_in_bytes() const noexcept { return blocks_.size() * sizeof(block); }
+
+        void insert(const uuid& key) noexcept {
+            auto h = hash(key);
+            auto& b = blocks_[block_index(h)];
+            for (int i = 0; i < 8; i++)
+                b.w[i] |= uint32_t{1} << ((static_cast<uint32_t>(h) * salt[i]) >> 27);
+        }
+
+        void insert(std::span<const uuid> keys) noexcept {
+            for (auto& u : keys)
+                insert(u);
+        }
+
+        bool may_contain(const uuid& key) const noexcept {
+            auto h = hash(key);
+            return test(blocks_[block_index(h)], h);
+        }
+
+        // Hashes and prefetches batch_size blocks before testing them.
+        // found[i] = may_contain(keys[i]), returns the number of positives
+        size_t may_contain_many(std::span<const uuid> keys, std::span<bool> found) const {
+            if (found.size() < keys.size())
+                throw std::invalid_argument("fquuid:may_contain_many: output span size insufficient");
+
+            size_t n = 0;
+            std::array<uint64_t, batch_size> h;
+            for (size_t b = 0; b < keys.size(); b += batch_size) {
+                auto m = std::min(batch_size, keys.size() - b);
+                for (size_t j = 0; j < m; j++) {
+                    h[j] = hash(keys[b + j]);
+                    detail::prefetch(&blocks_[block_index(h[j])]);
+                }
+                for (size_t j = 0; j < m; j++) {
+                    bool r = test(blocks_[block_index(h[j])], h[j]);
+                    found[b + j] = r;
+                    n += r;
+                }
+            }
+            return n;
+        }
+
+        size_t serialized_size() const noexcept {
+            return header_size + size_in_bytes();
+        }
+
+        size_t write_bytes(std::span<std::byte> bytes) const {
+            if (bytes.size() < serialized_size())
+                throw std::invalid_argument("fquuid:uuid_bloom_filter: output span size insufficient");
+
+            auto p = bytes.data();
+            detail::uuid_filter_format::write_magic(p, magic);
+            detail::store_le(p + 8, blocks_.size(), 8);
+            p += header_size;
+            for (auto& b : blocks_) {
+                for (auto w : b.w) {
+                    detail::store_le(p, w, 4);
+                    p += 4;
+                }
+            }
+            return serialized_size();
+        }
+
+        std::vector<std::byte> to_bytes() const {
+            std::vector<std::byte> v(serialized_size());
+            write_bytes(v);
+            return v;
+        }
+
+        static uuid_basic_bloom_filter from_bytes(std::span<const std::byte> bytes, const Hash& hash = Hash()) {
+            if (!detail::uuid_filter_format::check_magic(bytes, magic) || bytes.size() < header_size)
+                throw std::invalid_argument("fquuid:uuid_bloom_filter: invalid serialized data");
+
+            auto count = detail::load_le(bytes.data() + 8, 8);
+            if (count == 0 || count > (size_t{1} << 32) || bytes.size() - header_size != count * sizeof(block))
+                throw std::invalid_argument("fquuid:uuid_bloom_filter: invalid serialized data");
+
+            std::vector<block> blocks(count);
+            auto p = bytes.data() + header_size;
+            for (auto& b : blocks) {
+                for (auto& w : b.w) {
+                    w = static_cast<uint32_t>(detail::load_le(p, 4));
+                    p += 4;
+                }
+            }
+            return uuid_basic_bloom_filter(std::move(blocks), hash);
+        }
+    };
+
+    using uuid_bloom_filter = uuid_basic_bloom_filter<>;
+
+    // Binary fuse filter with 8-bit fingerprints (Graf and Lemire, 2022): immutable,
+    // about 9 bits per key for 0.39 % false positives, three memory accesses per lookup.
+    // Built in one go from all keys; duplicates are allowed.
+    template <class Hash = uuid_hash>
+    class uuid_basic_fuse_filter
+    {
+        static constexpr uint32_t arity = 3;
+        static constexpr uint32_t max_segment_length = 262144;
+        static constexpr int max_attempts = 100;
+
+        // "FQUUIDF1", seed, segment length, segment count, array length, fingerprints
+        static constexpr char magic[] = "FQUUIDF1";
+        static constexpr size_t header_size = 32;
+
+        static constexpr size_t batch_size = 16;
+
+        uint64_t seed_ = 0;
+        uint32_t segment_length_ = 4;
+        uint32_t segment_count_ = 1;
+        uint64_t segment_count_length_ = 4;
+        std::vector<uint8_t> fingerprints_ = std::vector<uint8_t>(12);
+        [[no_unique_address]] Hash hash_;
+
+        static uint64_t splitmix64(uint64_t& state) noexcept {
+            auto z = (state += 0x9e37'79b9'7f4a'7c15);
+            z = (z ^ (z >> 30)) * 0xbf58'476d'1ce4'e5b9;
+            z = (z ^ (z >> 27)) * 0x94d0'49bb'1331'11eb;
+            return z ^ (z >> 31);
+        }
+
+        // the key hash is computed once, each construction attempt only remixes it with its seed
+        static uint64_t remix(uint64_t h, uint64_t seed) noexcept {
+            h += seed;
+            h ^= h >> 33;
+            h *= 0xff51'afd7'ed55'8ccd;
+            h ^= h >> 33;
+            h *= 0xc4ce'b9fe'1a85'ec53;
+            h ^= h >> 33;
+            return h;
+        }
+
+        uint64_t hash(const uuid& key) const noexcept {
+            return remix(static_cast<uint64_t>(hash_(key)), seed_);
+        }
+
+        static uint8_t fingerprint(uint64_t h) noexcept {
+            return static_cast<uint8_t>(h ^ (h >> 32));
+        }
+
+        // one slot in each of three consecutive segments
+        std::array<uint64_t, 3> positions(uint64_t h) const noexcept {
+            uint64_t mask = segment_length_ - 1;
+            auto h0 = detail::mul_hi(h, segment_count_length_);
+            auto h1 = (h0 + segment_length_) ^ ((h >> 18) & mask);
+            auto h2 = (h0 + 2 * segment_length_) ^ (h & mask);
+            return { h0, h1, h2 };
+        }
+
+        bool test(uint64_t h) const noexcept {
+            auto [h0, h1, h2] = positions(h);
+            return (fingerprint(h) ^ fingerprints_[h0] ^ fingerprints_[h1] ^ fingerprints_[h2]) == 0;
+        }
+
+        void allocate(size_t size) {
+            segment_length_ = size == 0 ? 4
+                : std::min(max_segment_length, uint32_t{1} << static_cast<int>(std::floor(std::log(static_cast<double>(size)) / std::log(3.33) + 2.25)));
+            double size_factor = size <= 1 ? 0
+                : std::max(1.125, 0.875 + 0.25 * std::log(1'000'000.0) / std::log(static_cast<double>(size)));
+            auto capacity = static_cast<uint64_t>(std::round(static_cast<double>(size) * size_factor));
+
+            auto segments = (capacity + segment_length_ - 1) / segment_length_;
+            segment_count_ = static_cast<uint32_t>(segments <= arity - 1 ? 1 : segments - (arity - 1));
+            segment_count_length_ = uint64_t{segment_count_} * segment_length_;
+            fingerprints_.assign((uint64_t{segment_count_} + arity - 1) * segment_length_, 0);
+        }
+
+        void build(std::span<const uuid> keys) {
+            auto size = keys.size();
+            allocate(size);
+            if (size == 0)
+                return;
+
+            auto capacity = fingerprints_.size();
+            std::vector<uint64_t> hashes(size);
+            for (size_t i = 0; i < size; i++)
+                hashes[i] = static_cast<uint64_t>(hash_(keys[i]));
+
+            std::vector<uint64_t> reverse_order(size + 1);
+            std::vector<uint8_t> reverse_h(size);
+            std::vector<uint64_t> alone(capacity);
+            std::vector<uint8_t> t2count(capacity);
+            std::vector<uint64_t> t2hash(capacity);
+
+            int block_bits = 1;
+            while ((uint64_t{1} << block_bits) < segment_count_)
+                block_bits++;
+            std::vector<uint64_t> start_pos(size_t{1} << block_bits);
+            auto mod3 = [](uint8_t x) { return x > 2 ? static_cast<uint8_t>(x - 3) : x; };
+
+            uint64_t state = 0x726b'2b9d'438b'9d4d;
+            for (int attempt = 0;; attempt++) {
+                if (attempt == max_attempts)
+                    throw std::runtime_error("fquuid:uuid_fuse_filter: construction failed");
+
+                seed_ = splitmix64(state);
+                std::fill(reverse_order.begin(), reverse_order.end(), 0);
+                reverse_order[size] = 1; // sentinel
+                std::fill(t2count.begin(), t2count.end(), 0);
+                std::fill(t2hash.begin(), t2hash.end(), 0);
+
+                // bucket the hashes by their top bits so the next pass walks the table in order
+                auto block_mask = start_pos.size() - 1;
+                for (size_t i = 0; i < start_pos.size(); i++)
+                    start_pos[i] = (i * size) >> block_bits;
+                for (auto k : hashes) {
+                    auto h = remix(k, seed_);
+                    auto segment = h >> (64 - block_bits);
+                    while (reverse_order[start_pos[segment]] != 0) {
+                        segment++;
+                        segment &= block_mask;
+                    }
+                    reverse_order[start_pos[segment]] = h;
+                    start_pos[segment]++;
+                }
+
+                bool error = false;
+                size_t duplicates = 0;
+                for (size_t i = 0; i < size; i++) {
+                    auto h = reverse_order[i];
+                    auto [h0, h1, h2] = positions(h);
+                    t2count[h0] += 4;
+                    t2hash[h0] ^= h;
+                    t2count[h1] += 4;
+                    t2count[h1] ^= 1;
+                    t2hash[h1] ^= h;
+                    t2count[h2] += 4;
+                    t2count[h2] ^= 2;
+                    t2hash[h2] ^= h;
+
+                    // the same hash twice cancels out of t2hash
+                    if ((t2hash[h0] & t2hash[h1] & t2hash[h2]) == 0) {
+                        if ((t2hash[h0] == 0 && t2count[h0] == 8) || (t2hash[h1] == 0 && t2count[h1] == 8)
+                            || (t2hash[h2] == 0 && t2count[h2] == 8)) {
+                            duplicates++;
+                            t2count[h0] -= 4;
+                            t2hash[h0] ^= h;
+                            t2count[h1] -= 4;
+                            t2count[h1] ^= 1;
+                            t2hash[h1] ^= h;
+                            t2count[h2] -= 4;
+                            t2count[h2] ^= 2;
+                            t2hash[h2] ^= h;
+                        }
+                    }
+                    // a slot counter wrapped around
+                    error |= t2count[h0] < 4 || t2count[h1] < 4 || t2count[h2] < 4;
+                }
+                if (error)
+                    continue;
+
+                // peel slots holding a single key
+                size_t queue = 0;
+                for (size_t i = 0; i < capacity; i++) {
+                    alone[queue] = i;
+                    queue += (t2count[i] >> 2) == 1;
+                }
+
+                size_t stack = 0;
+                while (queue > 0) {
+                    auto index = alone[--queue];
+                    if ((t2count[index] >> 2) != 1)
+                        continue;
+
+                    auto h = t2hash[index];
+                    auto found = static_cast<uint8_t>(t2count[index] & 3);
+                    reverse_h[stack] = found;
+                    reverse_order[stack] = h;
+                    stack++;
+
+                    auto p = positions(h);
+                    std::array<uint64_t, 5> h012 { p[0], p[1], p[2], p[0], p[1] };
+                    for (uint8_t d = 1; d <= 2; d++) {
+                        auto other = h012[found + d];
+                        alone[queue] = other;
+                        queue += (t2count[other] >> 2) == 2;
+                        t2count[other] -= 4;
+                        t2count[other] ^= mod3(static_cast<uint8_t>(found + d));
+                        t2hash[other] ^= h;
+                    }
+                }
+
+                if (stack + duplicates != size) {
+                    // duplicates far apart in the input escape the check above and block the peeling
+                    if (duplicates > 0) {
+                        std::sort(hashes.begin(), hashes.end());
+                        hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+                        size = hashes.size();
+                        reverse_order.resize(size + 1);
+                    }
+                    continue;
+                }
+
+                // assign in reverse peeling order: each key owns the slot it was peeled from
+                std::fill(fingerprints_.begin(), fingerprints_.end(), 0);
+                for (size_t i = stack; i-- > 0;) {
+                    auto h = reverse_order[i];
+                    auto found = reverse_h[i];
+                    auto p = positions(h);
+                    std::array<uint64_t, 5> h012 { p[0], p[1], p[2], p[0], p[1] };
+                    fingerprints_[h012[found]] = static_cast<uint8_t>(
+                        fingerprint(h) ^ fingerprints_[h012[found + 1]] ^ fingerprints_[h012[found + 2]]);
+                }
+                return;
+            }
+        }
+
+        uuid_basic_fuse_filter(const Hash& hash, int) : hash_(hash) {}
+
+    public:
+        uuid_basic_fuse_filter() = default;
+
+        explicit uuid_basic_fuse_filter(std::span<const uuid> keys, const Hash& hash = Hash()) : hash_(hash) {
+            build(keys);
+        }
+
+        size_t size_in_bytes() const noexcept { return fingerprints_.size(); }
+
+        bool may_contain(const uuid& key) const noexcept {
+            return test(hash(key));
+        }
+
+        // Hashes and prefetches batch_size keys before testing them.
+        // found[i] = may_contain(keys[i]), returns the number of positives
+        size_t may_contain_many(std::span<const uuid> keys, std::span<bool> found) const {
+            if (found.size() < keys.size())
+                throw std::invalid_argument("fquuid:may_contain_many: output span size insufficient");
+
+            size_t n = 0;
+            std::array<uint64_t, batch_size> h;
+            for (size_t b = 0; b < keys.size(); b += batch_size) {
+                auto m = std::min(batch_size, keys.size() - b);
+                for (size_t j = 0; j < m; j++) {
+                    h[j] = hash(keys[b + j]);
+                    for (auto i : positions(h[j]))
+                        detail::prefetch(&fingerprints_[i]);
+                }
+                for (size_t j = 0; j < m; j++) {
+                    bool r = test(h[j]);
+                    found[b + j] = r;
+                    n += r;
+                }
+            }
+            return n;
+        }
+
+        size_t serialized_size() const noexcept {
+            return header_size + fingerprints_.size();
+        }
+
+        size_t write_bytes(std::span<std::byte> bytes) const {
+            if (bytes.size() < serialized_size())
+                throw std::invalid_argument("fquuid:uuid_fuse_filter: output span size insufficient");
+
+            auto p = bytes.data();
+            detail::uuid_filter_format::write_magic(p, magic);
+            detail::store_le(p + 8, seed_, 8);
+            detail::store_le(p + 16, segment_length_, 4);
+            detail::store_le(p + 20, segment_count_, 4);
+            detail::store_le(p + 24, fingerprints_.size(), 8);
+            std::memcpy(p + header_size, fingerprints_.data(), fingerprints_.size());
+            return serialized_size();
+        }
+
+        std::vector<std::byte> to_bytes() const {
+            std::vector<std::byte> v(serialized_size());
+            write_bytes(v);
+            return v;
+        }
+
+        static uuid_basic_fuse_filter from_bytes(std::span<const std::byte> bytes, const Hash& hash = Hash()) {
+            if (!detail::uuid_filter_format::check_magic(bytes, magic) || bytes.size() < header_size)
+                throw std::invalid_argument("fquuid:uuid_fuse_filter: invalid serialized data");
+
+            uuid_basic_fuse_filter f{hash, 0};
+            auto p = bytes.data();
+            f.seed_ = detail::load_le(p + 8, 8);
+            f.segment_length_ = static_cast<uint32_t>(detail::load_le(p + 16, 4));
+            f.segment_count_ = static_cast<uint32_t>(detail::load_le(p + 20, 4));
+            auto length = detail::load_le(p + 24, 8);
+
+            if (f.segment_length_ == 0 || f.segment_length_ > max_segment_length || !std::has_single_bit(f.segment_length_)
+                || f.segment_count_ == 0 || length != (uint64_t{f.segment_count_} + arity - 1) * f.segment_length_
+                || bytes.size() - header_size != length)
+                throw std::invalid_argument("fquuid:uuid_fuse_filter: invalid serialized data");
+
+            // positions() reaches up to two segments past segment_count_length_
+            f.segment_count_length_ = uint64_t{f.segment_count_} * f.segment_length_;
+            if (f.segment_count_length_ + 2 * uint64_t{f.segment_length_} > length)
+                throw std::invalid_argument("fquuid:uuid_fuse_filter: invalid serialized data");
+            f.fingerprints_.resize(length);
+            std::memcpy(f.fingerprints_.data(), p + header_size, length);
+            return f;
+        }
+    };
+
+    using uuid_fuse_filter = uuid_basic_fuse_filter<>;
+}
@@ -0,0 +1,66 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace fquuid
+{
+    // Null terminated string of exactly N characters held inline,
+    // returned by uuid::to_chars() without touching the allocator.
+    template <class CharT, size_t N = 36>
+    class uuid_basic_fixed_string
+    {
+        std::array<CharT, N + 1> s_ {};
+
+    public:
+        using value_type = CharT;
+        using size_type = size_t;
+        using traits_type = std::char_traits<CharT>;
+        using string_view_type = std::basic_string_view<CharT>;
+        using const_iterator = typename std::array<CharT, N + 1>::const_iterator;
+
+        constexpr uuid_basic_fixed_string() noexcept = default;
+
+        static constexpr size_type size() noexcept { return N; }
+        static constexpr size_type length() noexcept { return N; }
+        static constexpr bool empty() noexcept { return N == 0; }
+
+        constexpr CharT* data() noexcept { return s_.data(); }
+        constexpr const CharT* data() const noexcept { return s_.data(); }
+        constexpr const CharT* c_str() const noexcept { return s_.data(); }
+
+        constexpr const_iterator begin() const noexcept { return s_.begin(); }
+        constexpr const_iterator end() const noexcept { return s_.begin() + N; }
+
+        constexpr const CharT& operator [](size_type i) const noexcept { return s_[i]; }
+
+        constexpr string_view_type view() const noexcept { return { s_.data(), N }; }
+
+        constexpr operator string_view_type() const noexcept { return view(); }
+        constexpr operator const CharT*() const noexcept { return s_.data(); }
+
+        friend constexpr bool operator ==(const uuid_basic_fixed_string&, const uuid_basic_fixed_string&) = default;
+
+        friend constexpr bool operator ==(const uuid_basic_fixed_string& a, string_view_type b) noexcept {
+            return a.view() == b;
+        }
+
+        friend constexpr bool operator ==(const uuid_basic_fixed_string& a, const CharT* b) noexcept {
+            return a.view() == string_view_type(b);
+        }
+
+        friend constexpr auto operator <=>(const uuid_basic_fixed_string& a, const uuid_basic_fixed_string& b) noexcept {
+            return a.view() <=> b.view();
+        }
+    };
+
+    using uuid_fixed_string = uuid_basic_fixed_string<char>;
+    using uuid_fixed_wstring = uuid_basic_fixed_string<wchar_t>;
+    using uuid_fixed_u8string = uuid_basic_fixed_string<char8_t>;
+    using uuid_fixed_u16string = uuid_basic_fixed_string<char16_t>;
+    using uuid_fixed_u32string = uuid_basic_fixed_string<char32_t>;
+}
@@ -0,0 +1,574 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "fquuid_uuid.hpp"
+#include "fquuid_hash.hpp"
+#include "fquuid_simd.hpp"
+
+namespace fquuid::detail
+{
+    // 16 control bytes probed at once.
+    // empty / deleted have the top bit set, a full slot holds the low 7 bits of the hash.
+    struct alignas(16) uuid_ctrl_group
+    {
+        static constexpr uint8_t empty = 0x80;
+        static constexpr uint8_t deleted = 0xfe;
+
+        uint8_t c[16];
+
+        // bit i: c[i] == h2
+        uint32_t match(uint8_t h2) const noexcept {
+#ifdef FQUUID_SIMD_SSE2
+            auto g = _mm_load_si128(reinterpret_cast<const __m128i*>(c));
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8(static_cast<char>(h2)))));
+#else
+            uint32_t m = 0;
+            for (int i = 0; i < 16; i++)
+                m |= static_cast<uint32_t>(c[i] == h2) << i;
+            return m;
+#endif
+        }
+
+        uint32_t match_empty() const noexcept {
+            return match(empty);
+        }
+
+        // empty or deleted
+        uint32_t match_free() const noexcept {
+#ifdef FQUUID_SIMD_SSE2
+            auto g = _mm_load_si128(reinterpret_cast<const __m128i*>(c));
+            return static_cast<uint32_t>(_mm_movemask_epi8(g));
+#else
+            uint32_t m = 0;
+            for (int i = 0; i < 16; i++)
+                m |= static_cast<uint32_t>(c[i] >> 7) << i;
+            return m;
+#endif
+        }
+    };
+
+    // Swiss-table style open addressing table for uuid keys.
+    // Value = void makes a set. Key slots of a set table start as nil,
+    // but the control bytes decide occupancy, so nil is an ordinary key.
+    template <class Value, class Hash>
+    class uuid_flat_table
+    {
+        static constexpr bool is_set = std::is_void_v<Value>;
+        static constexpr size_t group_size = 16;
+        static constexpr size_t min_capacity = group_size;
+        static constexpr size_t find_batch = 8;
+
+        template <class V>
+        struct slot_of { using type = std::pair<const uuid, V>; };
+
+        template <class V>
+            requires std::is_void_v<V>
+        struct slot_of<V> { using type = uuid; };
+
+    public:
+        using key_type = uuid;
+        using mapped_type = Value;
+        using value_type = typename slot_of<Value>::type;
+        using size_type = size_t;
+        using hasher = Hash;
+
+    private:
+        using allocator = std::allocator<value_type>;
+
+        std::unique_ptr<uuid_ctrl_group[]> ctrl_;
+        value_type* slots_ = nullptr;
+        size_t capacity_ = 0;   // 0 or a power of two >= 16
+        size_t size_ = 0;
+        size_t deleted_ = 0;
+        [[no_unique_address]] Hash hash_;
+
+        static const uuid& key_of(const value_type& s) noexcept {
+            if constexpr (is_set)
+                return s;
+            else
+                return s.first;
+        }
+
+        bool is_full(size_t i) const noexcept {
+            return (ctrl_[i / group_size].c[i % group_size] & 0x80) == 0;
+        }
+
+        void set_ctrl(size_t i, uint8_t c) noexcept {
+            ctrl_[i / group_size].c[i % group_size] = c;
+        }
+
+        size_t group_mask() const noexcept {
+            return capacity_ / group_size - 1;
+        }
+
+        static constexpr size_t max_load(size_t capacity) noexcept {
+            return capacity - capacity / 8;
+        }
+
+        static uint8_t h2_of(size_t h) noexcept {
+            return static_cast<uint8_t>(h & 0x7f);
+        }
+
+        static size_t h1_of(size_t h) noexcept {
+            return h >> 7;
+        }
+
+        // triangular probing over groups visits every group once
+        template <class Fn>
+        size_t probe(size_t h, Fn fn) const noexcept {
+            auto mask = group_mask();
+            auto g = h1_of(h) & mask;
+            for (size_t step = 1; ; step++) {
+                if (auto r = fn(g); r != npos)
+                    return r;
+                g = (g + step) & mask;
+            }
+        }
+
+        static constexpr size_t npos = ~size_t{0};
+        static constexpr size_t probe_next = npos;
+        static constexpr size_t probe_miss = npos - 1;
+
+        size_t find_index(const uuid& key, size_t h) const noexcept {
+            if (capacity_ == 0)
+                return npos;
+
+            auto h2 = h2_of(h);
+            auto r = probe(h, [&](size_t g) {
+                auto& grp = ctrl_[g];
+                for (auto m = grp.match(h2); m != 0; m &= m - 1) {
+                    auto i = g * group_size + std::countr_zero(m);
+                    if (key_of(slots_[i]) == key)
+                        return i;
+                }
+                return grp.match_empty() != 0 ? probe_miss : probe_next;
+            });
+            return r == probe_miss ? npos : r;
+        }
+
+        size_t find_free(size_t h) const noexcept {
+            return probe(h, [&](size_t g) {
+                auto m = ctrl_[g].match_free();
+                return m != 0 ? g * group_size + std::countr_zero(m) : probe_next;
+            });
+        }
+
+        value_type* allocate_slots(size_t capacity) {
+            auto p = allocator{}.allocate(capacity);
+            if constexpr (is_set)
+                std::uninitialized_value_construct_n(p, capacity);
+            return p;
+        }
+
+        void destroy_slots() noexcept {
+            if (slots_ == nullptr)
+                return;
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                for (size_t i = 0; i < capacity_; i++) {
+                    if (is_full(i))
+                        std::destroy_at(slots_ + i);
+                }
+            }
+            allocator{}.deallocate(slots_, capacity_);
+            slots_ = nullptr;
+        }
+
+        // Strong guarantee: the new arrays are allocated before anything changes, and a value whose
+        // move may throw is copied, so on a throw the new arrays are dropped and the old ones kept.
+        void rehash_to(size_t capacity) {
+            auto ctrl = std::make_unique<uuid_ctrl_group[]>(capacity / group_size);
+            for (size_t g = 0; g < capacity / group_size; g++)
+                std::fill(std::begin(ctrl[g].c), std::end(ctrl[g].c), uuid_ctrl_group::empty);
+            auto slots = allocate_slots(capacity);
+
+            // ctrl, slots and capacity hold the old table from here on
+            std::swap(ctrl_, ctrl);
+            std::swap(slots_, slots);
+            std::swap(capacity_, capacity);
+            auto deleted = std::exchange(deleted_, 0);
+            auto was_full = [&](size_t i) { return (ctrl[i / group_size].c[i % group_size] & 0x80) == 0; };
+
+            try {
+                for (size_t i = 0; i < capacity; i++) {
+                    if (!was_full(i))
+                        continue;
+
+                    auto& s = slots[i];
+                    auto h = hash_(key_of(s));
+                    auto j = find_free(h);
+                    if constexpr (is_set)
+                        slots_[j] = s;
+                    else
+                        std::construct_at(slots_ + j, s.first, std::move_if_noexcept(s.second));
+                    set_ctrl(j, h2_of(h));
+                }
+            }
+            catch (...) {
+                destroy_slots();
+                std::swap(ctrl_, ctrl);
+                std::swap(slots_, slots);
+                std::swap(capacity_, capacity);
+                deleted_ = deleted;
+                throw;
+            }
+
+            if constexpr (!std::is_trivially_destructible_v<value_type>) {
+                for (size_t i = 0; i < capacity; i++) {
+                    if (was_full(i))
+                        std::destroy_at(slots + i);
+                }
+            }
+            if (slots != nullptr)
+                allocator{}.deallocate(slots, capacity);
+        }
+
+        void reserve_one() {
+            if (size_ + deleted_ + 1 <= max_load(capacity_))
+                return;
+            // mostly tombstones: clean up in place, otherwise grow
+            if (capacity_ != 0 && size_ + 1 <= max_load(capacity_) / 2)
+                rehash_to(capacity_);
+            else
+                rehash_to(std::max(min_capacity, capacity_ * 2));
+        }
+
+        // slot for key, constructed by make(slot) when absent
+        template <class Make>
+        std::pair<size_t, bool> find_or_insert(const uuid& key, Make make) {
+            auto h = hash_(key);
+            if (auto i = find_index(key, h); i != npos)
+                return { i, false };
+
+            reserve_one();
+            auto i = find_free(h);
+            if (ctrl_[i / group_size].c[i % group_size] == uuid_ctrl_group::deleted)
+                deleted_--;
+            make(slots_ + i);
+            set_ctrl(i, h2_of(h));
+            size_++;
+            return { i, true };
+        }
+
+        void erase_index(size_t i) noexcept {
+            auto g = i / group_size;
+            if constexpr (is_set)
+                slots_[i] = uuid{};
+            else
+                std::destroy_at(slots_ + i);
+
+            // a group that still has an empty slot was never probed past
+            if (ctrl_[g].match_empty() != 0) {
+                set_ctrl(i, uuid_ctrl_group::empty);
+            } else {
+                set_ctrl(i, uuid_ctrl_group::deleted);
+                deleted_++;
+            }
+            size_--;
+        }
+
+        template <class Fn>
+        void find_batch_impl(std::span<const uuid> keys, Fn fn) const {
+            for (size_t base = 0; base < keys.size(); base += find_batch) {
+                auto n = std::min(find_batch, keys.size() - base);
+                size_t hashes[find_batch];
+                for (size_t k = 0; k < n; k++) {
+                    hashes[k] = hash_(keys[base + k]);
+                    if (capacity_ != 0) {
+                        auto g = h1_of(hashes[k]) & group_mask();
+                        prefetch(&ctrl_[g]);
+                        prefetch(slots_ + g * group_size);
+                    }
+                }
+                for (size_t k = 0; k < n; k++)
+                    fn(base + k, find_index(keys[base + k], hashes[k]));
+            }
+        }
+
+        template <bool Const>
+        class basic_iterator
+        {
+            friend class uuid_flat_table;
+            template <bool> friend class basic_iterator;
+            using table_ptr = std::conditional_t<Const, const uuid_flat_table*, uuid_flat_table*>;
+
+            table_ptr t_ = nullptr;
+            size_t i_ = 0;
+
+            basic_iterator(table_ptr t, size_t i) noexcept : t_(t), i_(i) { skip(); }
+
+            void skip() noexcept {
+                while (i_ < t_->capacity_ && !t_->is_full(i_))
+                    i_++;
+            }
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = typename uuid_flat_table::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::conditional_t<Const || is_set, const value_type&, value_type&>;
+            using pointer = std::conditional_t<Const || is_set, const value_type*, value_type*>;
+
+            basic_iterator() noexcept = default;
+
+            operator basic_iterator<true>() const noexcept
+                requires (!Const) {
+                return basic_iterator<true>(t_, i_);
+            }
+
+            reference operator *() const noexcept { return t_->slots_[i_]; }
+            pointer operator ->() const noexcept { return t_->slots_ + i_; }
+
+            basic_iterator& operator ++() noexcept {
+                i_++;
+                skip();
+                return *this;
+            }
+
+            basic_iterator operator ++(int) noexcept {
+                auto r = *this;
+                ++*this;
+                return r;
+            }
+
+            friend bool operator ==(const basic_iterator& a, const basic_iterator& b) noexcept {
+                return a.i_ == b.i_;
+            }
+        };
+
+    public:
+        using iterator = basic_iterator<is_set>;
+        using const_iterator = basic_iterator<true>;
+
+        uuid_flat_table() = default;
+
+        explicit uuid_flat_table(size_t n, const Hash& hash = Hash()) : hash_(hash) {
+            reserve(n);
+        }
+
+        uuid_flat_table(std::initializer_list<value_type> init, const Hash& hash = Hash()) : hash_(hash) {
+            reserve(init.size());
+            for (auto& s : init) {
+                if constexpr (is_set)
+                    insert(s);
+                else
+                    try_emplace(s.first, s.second);
+            }
+        }
+
+        uuid_flat_table(const uuid_flat_table& r) : hash_(r.hash_) {
+            reserve(r.size_);
+            for (auto& s : r) {
+                if constexpr (is_set)
+                    insert(s);
+                else
+                    try_emplace(s.first, s.second);
+            }
+        }
+
+        uuid_flat_table(uuid_flat_table&& r) noexcept
+            : ctrl_(std::move(r.ctrl_)),
+              slots_(std::exchange(r.slots_, nullptr)),
+              capacity_(std::exchange(r.capacity_, 0)),
+              size_(std::exchange(r.size_, 0)),
+              deleted_(std::exchange(r.deleted_, 0)),
+              hash_(r.hash_) {}
+
+        uuid_flat_table& operator =(const uuid_flat_table& r) {
+            if (this != &r) {
+                auto t = r;
+                *this = std::move(t);
+            }
+            return *this;
+        }
+
+        uuid_flat_table& operator =(uuid_flat_table&& r) noexcept {
+            if (this != &r) {
+                destroy_slots();
+                ctrl_ = std::move(r.ctrl_);
+                slots_ = std::exchange(r.slots_, nullptr);
+                capacity_ = std::exchange(r.capacity_, 0);
+                size_ = std::exchange(r.size_, 0);
+                deleted_ = std::exchange(r.deleted_, 0);
+                hash_ = r.hash_;
+            }
+            return *this;
+        }
+
+        ~uuid_flat_table() {
+            destroy_slots();
+        }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t capacity() const noexcept { return capacity_; }
+        hasher hash_function() const { return hash_; }
+
+        iterator begin() noexcept { return iterator(this, 0); }
+        iterator end() noexcept { return iterator(this, capacity_); }
+        const_iterator begin() const noexcept { return const_iterator(this, 0); }
+        const_iterator end() const noexcept { return const_iterator(this, capacity_); }
+
+        // room for n elements without rehashing
+        void reserve(size_t n) {
+            auto capacity = std::max(min_capacity, std::bit_ceil(n + n / 7 + 1));
+            if (capacity > capacity_)
+                rehash_to(capacity);
+        }
+
+        void clear() noexcept {
+            destroy_slots();
+            ctrl_.reset();
+            capacity_ = size_ = deleted_ = 0;
+        }
+
+        iterator find(const uuid& key) noexcept {
+            auto i = find_index(key, hash_(key));
+            return i == npos ? end() : iterator(this, i);
+        }
+
+        const_iterator find(const uuid& key) const noexcept {
+            auto i = find_index(key, hash_(key));
+            return i == npos ? end() : const_iterator(this, i);
+        }
+
+        bool contains(const uuid& key) const noexcept {
+            return find_index(key, hash_(key)) != npos;
+        }
+
+        size_t count(const uuid& key) const noexcept {
+            return contains(key) ? 1 : 0;
+        }
+
+        size_t erase(const uuid& key) noexcept {
+            auto i = find_index(key, hash_(key));
+            if (i == npos)
+                return 0;
+            erase_index(i);
+            return 1;
+        }
+
+        // set
+
+        std::pair<iterator, bool> insert(const uuid& key)
+            requires is_set {
+            auto [i, inserted] = find_or_insert(key, [&](uuid* s) { *s = key; });
+            return { iterator(this, i), inserted };
+        }
+
+        // found[i]: keys[i] is in the set, returns the number found
+        size_t find_many(std::span<const uuid> keys, std::span<bool> found) const
+            requires is_set {
+            if (found.size() < keys.size())
+                throw std::invalid_argument("fquuid:find_many: output span size insufficient");
+
+            size_t n = 0;
+            find_batch_impl(keys, [&](size_t k, size_t i) {
+                found[k] = i != npos;
+                n += i != npos;
+            });
+            return n;
+        }
+
+        // map
+
+        template <class V = Value, class... Args>
+            requires (!is_set)
+        std::pair<iterator, bool> try_emplace(const uuid& key, Args&&... args) {
+            auto [i, inserted] = find_or_insert(key, [&](value_type* s) {
+                std::construct_at(s, std::piecewise_construct,
+                                  std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+            });
+            return { iterator(this, i), inserted };
+        }
+
+        template <class V = Value>
+            requires (!is_set)
+        std::pair<iterator, bool> insert(const std::pair<const uuid, V>& kv) {
+            return try_emplace(kv.first, kv.second);
+        }
+
+        template <class V = Value, class M>
+            requires (!is_set)
+        std::pair<iterator, bool> insert_or_assign(const uuid& key, M&& m) {
+            auto r = try_emplace(key, std::forward<M>(m));
+            if (!r.second)
+                r.first->second = std::forward<M>(m);
+            return r;
+        }
+
+        template <class V = Value>
+            requires (!is_set)
+        V& operator [](const uuid& key) {
+            return try_emplace(key).first->second;
+        }
+
+        template <class V = Value>
+            requires (!is_set)
+        V& at(const uuid& key) {
+            auto i = find_index(key, hash_(key));
+            if (i == npos)
+                throw std::out_of_range("fquuid:uuid_flat_map: key not found");
+            return slots_[i].second;
+        }
+
+        template <class V = Value>
+            requires (!is_set)
+        const V& at(const uuid& key) const {
+            auto i = find_index(key, hash_(key));
+            if (i == npos)
+                throw std::out_of_range("fquuid:uuid_flat_map: key not found");
+            return slots_[i].second;
+        }
+
+        // out[i]: mapped value of keys[i] or nullptr, returns the number found
+        template <class V = Value>
+            requires (!is_set)
+        size_t find_many(std::span<const uuid> keys, std::span<V*> out) {
+            if (out.size() < keys.size())
+                throw std::invalid_argument("fquuid:find_many: output span size insufficient");
+
+            size_t n = 0;
+            find_batch_impl(keys, [&](size_t k, size_t i) {
+                out[k] = i != npos ? &slots_[i].second : nullptr;
+                n += i != npos;
+            });
+            return n;
+        }
+
+        template <class V = Value>
+            requires (!is_set)
+        size_t find_many(std::span<const uuid> keys, std::span<const V*> out) const {
+            if (out.size() < keys.size())
+                throw std::invalid_argument("fquuid:find_many: output span size insufficient");
+
+            size_t n = 0;
+            find_batch_impl(keys, [&](size_t k, size_t i) {
+                out[k] = i != npos ? &slots_[i].second : nullptr;
+                n += i != npos;
+            });
+            return n;
+        }
+    };
+}
+
+namespace fquuid
+{
+    template <class Hash>
+    using uuid_basic_flat_set = detail::uuid_flat_table<void, Hash>;
+
+    template <class T, class Hash = uuid_hash>
+    using uuid_flat_map = detail::uuid_flat_table<T, Hash>;
+
+    using uuid_flat_set = uuid_basic_flat_set<uuid_hash>;
+}
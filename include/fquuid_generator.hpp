@@ -57,4 +57,22 @@ namespace fquuid
             return uuid{u};
         }
     };
+
+    // Smallest and largest v7 uuid of a millisecond, bounds for timestamp range scans.
+    // 0 <= unix_ts_ms < 2^48
+    constexpr uuid uuid_v7_min(int64_t unix_ts_ms) noexcept {
+        detail::uuid_u128 u {};
+        u.unix_ts_ms(unix_ts_ms);
+        u.version(7);
+        u.variant(0b10);
+        return uuid{u};
+    }
+
+    constexpr uuid uuid_v7_max(int64_t unix_ts_ms) noexcept {
+        detail::uuid_u128 u { 0xffff, 0xffff'ffff'ffff'ffff };
+        u.unix_ts_ms(unix_ts_ms);
+        u.version(7);
+        u.variant(0b10);
+        return uuid{u};
+    }
 }
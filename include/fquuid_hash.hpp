@@ -0,0 +1,60 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "fquuid_uuid.hpp"
+#include "fquuid_random.hpp"
+
+namespace fquuid
+{
+    // Same as std::hash<uuid>
+    struct uuid_hash
+    {
+        constexpr size_t operator ()(const uuid& u) const noexcept {
+            return u.hash();
+        }
+    };
+
+    // Keyed hash for tables filled from untrusted input (HashDoS).
+    // Default constructed instances share a random per-process seed.
+    class uuid_seeded_hash
+    {
+        uint64_t seed_;
+
+        static uint64_t process_seed() {
+            static const uint64_t seed = uuid_random{}();
+            return seed;
+        }
+
+    public:
+        uuid_seeded_hash() : seed_(process_seed()) {}
+
+        constexpr explicit uuid_seeded_hash(uint64_t seed) noexcept : seed_(seed) {}
+
+        constexpr uint64_t seed() const noexcept { return seed_; }
+
+        constexpr size_t operator ()(const uuid& u) const noexcept {
+            return u.hash(seed_);
+        }
+    };
+
+    // Uses the random bits of v4 keys without mixing.
+    // Only for keys generated by a trusted random source; v7 and crafted keys cluster.
+    struct uuid_trusted_v4_hash
+    {
+        constexpr size_t operator ()(const uuid& u) const noexcept {
+            return u.hash_trusted_v4();
+        }
+    };
+
+    // Mixes only the random bits of v7 keys (rand_a, rand_b), ignoring the timestamp,
+    // so where a key lands does not depend on when it was generated.
+    // Keys of other versions lose their upper 48 bits.
+    struct uuid_v7_random_hash
+    {
+        constexpr size_t operator ()(const uuid& u) const noexcept {
+            return u.hash_v7_random();
+        }
+    };
+}
@@ -0,0 +1,8 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#ifdef _WIN32
+#include "fquuid_mmap_windows.hpp"
+#else
+#include "fquuid_mmap_unix.hpp"
+#endif
@@ -0,0 +1,107 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace fquuid::detail
+{
+    // Read-only mapping of a whole file
+    class uuid_mapped_file
+    {
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+
+        static std::runtime_error error() {
+            return std::runtime_error(std::string("fquuid:uuid_mapped_file: ") + strerror(errno));
+        }
+
+        void unmap() noexcept {
+            if (data_ != nullptr) {
+                munmap(const_cast<std::byte*>(data_), size_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+    public:
+        uuid_mapped_file() = default;
+
+        explicit uuid_mapped_file(const std::filesystem::path& path) {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd == -1)
+                throw error();
+
+            struct stat st;
+            if (fstat(fd, &st) == -1) {
+                auto e = error();
+                ::close(fd);
+                throw e;
+            }
+
+            // an empty file can't be mapped
+            if (st.st_size > 0) {
+                auto p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+                if (p == MAP_FAILED) {
+                    auto e = error();
+                    ::close(fd);
+                    throw e;
+                }
+                data_ = static_cast<const std::byte*>(p);
+                size_ = static_cast<size_t>(st.st_size);
+            }
+            ::close(fd);
+        }
+
+        ~uuid_mapped_file() {
+            unmap();
+        }
+
+        uuid_mapped_file(uuid_mapped_file&& r) noexcept : data_(r.data_), size_(r.size_) {
+            r.data_ = nullptr;
+            r.size_ = 0;
+        }
+
+        uuid_mapped_file& operator =(uuid_mapped_file&& r) noexcept {
+            if (this != &r) {
+                unmap();
+                data_ = r.data_;
+                size_ = r.size_;
+                r.data_ = nullptr;
+                r.size_ = 0;
+            }
+            return *this;
+        }
+
+        uuid_mapped_file(const uuid_mapped_file&) = delete;
+        uuid_mapped_file& operator =(const uuid_mapped_file&) = delete;
+
+        std::span<const std::byte> bytes() const noexcept {
+            return std::span(data_, size_);
+        }
+    };
+    // Flushes f and its data to the device
+    inline bool sync_file(std::FILE* f) noexcept {
+        return std::fflush(f) == 0 && ::fsync(fileno(f)) == 0;
+    }
+
+    // Makes a rename or a new entry in the directory durable
+    inline bool sync_directory(const std::filesystem::path& dir) noexcept {
+        int fd = ::open(dir.empty() ? "." : dir.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            return false;
+        bool ok = ::fsync(fd) == 0;
+        ::close(fd);
+        return ok;
+    }
+}
@@ -0,0 +1,102 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#define NOMINMAX
+#include <windows.h>
+#undef NOMINMAX
+#include <io.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+
+namespace fquuid::detail
+{
+    // Read-only mapping of a whole file
+    class uuid_mapped_file
+    {
+        const std::byte* data_ = nullptr;
+        size_t size_ = 0;
+
+        void unmap() noexcept {
+            if (data_ != nullptr) {
+                UnmapViewOfFile(data_);
+                data_ = nullptr;
+                size_ = 0;
+            }
+        }
+
+    public:
+        uuid_mapped_file() = default;
+
+        explicit uuid_mapped_file(const std::filesystem::path& path) {
+            auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (file == INVALID_HANDLE_VALUE)
+                throw std::runtime_error("fquuid:uuid_mapped_file: can't open file");
+
+            LARGE_INTEGER size;
+            if (!GetFileSizeEx(file, &size)) {
+                CloseHandle(file);
+                throw std::runtime_error("fquuid:uuid_mapped_file: GetFileSizeEx failed");
+            }
+
+            // an empty file can't be mapped
+            if (size.QuadPart > 0) {
+                auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (mapping == nullptr)
+                    throw std::runtime_error("fquuid:uuid_mapped_file: CreateFileMapping failed");
+
+                auto p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (p == nullptr)
+                    throw std::runtime_error("fquuid:uuid_mapped_file: MapViewOfFile failed");
+
+                data_ = static_cast<const std::byte*>(p);
+                size_ = static_cast<size_t>(size.QuadPart);
+            }
+            else
+                CloseHandle(file);
+        }
+
+        ~uuid_mapped_file() {
+            unmap();
+        }
+
+        uuid_mapped_file(uuid_mapped_file&& r) noexcept : data_(r.data_), size_(r.size_) {
+            r.data_ = nullptr;
+            r.size_ = 0;
+        }
+
+        uuid_mapped_file& operator =(uuid_mapped_file&& r) noexcept {
+            if (this != &r) {
+                unmap();
+                data_ = r.data_;
+                size_ = r.size_;
+                r.data_ = nullptr;
+                r.size_ = 0;
+            }
+            return *this;
+        }
+
+        uuid_mapped_file(const uuid_mapped_file&) = delete;
+        uuid_mapped_file& operator =(const uuid_mapped_file&) = delete;
+
+        std::span<const std::byte> bytes() const noexcept {
+            return std::span(data_, size_);
+        }
+    };
+    // Flushes f and its data to the device
+    inline bool sync_file(std::FILE* f) noexcept {
+        auto h = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(f)));
+        return std::fflush(f) == 0 && h != INVALID_HANDLE_VALUE && FlushFileBuffers(h);
+    }
+
+    // NTFS journals the rename itself, there is no directory handle to flush
+    inline bool sync_directory(const std::filesystem::path&) noexcept {
+        return true;
+    }
+}
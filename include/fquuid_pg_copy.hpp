@@ -0,0 +1,313 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "fquuid_uuid.hpp"
+#include "fquuid_types.hpp"
+#include "fquuid_bulk.hpp"
+
+namespace fquuid::detail
+{
+    // PostgreSQL binary COPY, https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+    //   header:  "PGCOPY\n\377\r\n\0", int32 flags, int32 header extension length, extension
+    //   tuple:   int16 field count, then per field int32 length (-1 for NULL) and the value
+    //   trailer: int16 -1
+    // Integers are big-endian; a uuid value is its 16 bytes in big-endian order.
+    struct uuid_pg_copy_format
+    {
+        static constexpr std::array<uint8_t, 11> signature { 'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xff, '\r', '\n', 0 };
+        static constexpr size_t header_size = 19;
+        static constexpr size_t trailer_size = 2;
+        static constexpr size_t field_size = 20;
+        static constexpr size_t null_field_size = 4;
+        static constexpr uint32_t flag_oids = uint32_t{1} << 16;
+        static constexpr uint32_t flags_critical = 0xffff; // bits 0-15: unknown ones must abort the read
+        static constexpr size_t batch = 64;
+
+        static void store_be(std::byte* p, uint32_t v, int bytes) noexcept {
+            for (int i = 0; i < bytes; i++)
+                p[i] = static_cast<std::byte>(v >> (8 * (bytes - 1 - i)));
+        }
+
+        static uint32_t load_be(const std::byte* p, int bytes) noexcept {
+            uint32_t v = 0;
+            for (int i = 0; i < bytes; i++)
+                v = v << 8 | std::to_integer<uint32_t>(p[i]);
+            return v;
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Values and bytes handled by one call of uuid_pg_copy_writer / uuid_pg_copy_reader
+    struct uuid_pg_copy_progress
+    {
+        size_t values = 0;
+        size_t bytes = 0;
+    };
+
+    // Writes rows of uuid (or nullable uuid) columns in the PostgreSQL binary COPY format,
+    // e.g. for COPY t FROM STDIN (FORMAT binary).
+    // Output goes to caller buffers: write_header, then write_rows with as many buffers as needed,
+    // then write_trailer. Nothing is allocated.
+    class uuid_pg_copy_writer
+    {
+        using format = detail::uuid_pg_copy_format;
+
+        size_t columns_;
+
+        static void need(std::span<std::byte> out, size_t n) {
+            if (out.size() < n)
+                throw std::invalid_argument("fquuid:uuid_pg_copy_writer: output span size insufficient");
+        }
+
+    public:
+        explicit uuid_pg_copy_writer(size_t columns = 1) : columns_(columns) {
+            if (columns == 0 || columns > 1600) // MaxTupleAttributeNumber
+                throw std::invalid_argument("fquuid:uuid_pg_copy_writer: invalid column count");
+        }
+
+        size_t columns() const noexcept { return columns_; }
+
+        // bytes of a row without NULLs, the most any row takes
+        size_t row_size() const noexcept { return 2 + format::field_size * columns_; }
+
+        size_t write_header(std::span<std::byte> out) const {
+            need(out, format::header_size);
+            std::memcpy(out.data(), format::signature.data(), format::signature.size());
+            std::fill_n(out.data() + format::signature.size(), 8, std::byte{0});
+            return format::header_size;
+        }
+
+        size_t write_trailer(std::span<std::byte> out) const {
+            need(out, format::trailer_size);
+            format::store_be(out.data(), 0xffff, 2);
+            return format::trailer_size;
+        }
+
+        // Writes the rows of values (columns() values per row, a multiple of columns()) that fit into out.
+        // Call again with the remaining values and a fresh buffer until progress.values == values.size().
+        uuid_pg_copy_progress write_rows(std::span<const uuid> values, std::span<std::byte> out) const {
+            if (values.size() % columns_ != 0)
+                throw std::invalid_argument("fquuid:uuid_pg_copy_writer: values not a multiple of the column count");
+
+            auto rows = std::min(values.size() / columns_, out.size() / row_size());
+            auto p = out.data();
+            size_t col = 0;
+
+            // big-endian values in batches through store_many, then framed
+            std::array<std::byte, 16 * format::batch> be;
+            for (size_t b = 0; b < rows * columns_; b += format::batch) {
+                auto chunk = values.subspan(b, std::min(format::batch, rows * columns_ - b));
+                store_many(chunk, std::span(be));
+                for (size_t i = 0; i < chunk.size(); i++) {
+                    if (col == 0) {
+                        format::store_be(p, static_cast<uint32_t>(columns_), 2);
+                        p += 2;
+                    }
+                    format::store_be(p, 16, 4);
+                    std::memcpy(p + 4, be.data() + 16 * i, 16);
+                    p += format::field_size;
+                    col = col + 1 == columns_ ? 0 : col + 1;
+                }
+            }
+            return { rows * columns_, static_cast<size_t>(p - out.data()) };
+        }
+
+        // As write_rows, nulls[i] writes NULL in place of values[i]
+        uuid_pg_copy_progress write_rows(std::span<const uuid> values, std::span<const bool> nulls, std::span<std::byte> out) const {
+            if (values.size() % columns_ != 0)
+                throw std::invalid_argument("fquuid:uuid_pg_copy_writer: values not a multiple of the column count");
+            if (nulls.size() < values.size())
+                throw std::invalid_argument("fquuid:uuid_pg_copy_writer: nulls span size insufficient");
+
+            // the whole rows that fit
+            size_t n = 0;
+            size_t bytes = 0;
+            while (n < values.size()) {
+                size_t size = 2;
+                for (size_t c = 0; c < columns_; c++)
+                    size += nulls[n + c] ? format::null_field_size : format::field_size;
+                if (out.size() - bytes < size)
+                    break;
+                bytes += size;
+                n += columns_;
+            }
+
+            // the non-NULL values of each batch gathered through store_many, then framed
+            auto p = out.data();
+            size_t col = 0;
+            std::array<uuid, format::batch> gathered;
+            std::array<std::byte, 16 * format::batch> be;
+            for (size_t b = 0; b < n; b += format::batch) {
+                auto count = std::min(format::batch, n - b);
+                size_t k = 0;
+                for (size_t i = 0; i < count; i++) {
+                    if (!nulls[b + i])
+                        gathered[k++] = values[b + i];
+                }
+                store_many(std::span<const uuid>(gathered.data(), k), std::span(be));
+
+                k = 0;
+                for (size_t i = 0; i < count; i++) {
+                    if (col == 0) {
+                        format::store_be(p, static_cast<uint32_t>(columns_), 2);
+                        p += 2;
+                    }
+                    if (nulls[b + i]) {
+                        format::store_be(p, 0xffff'ffff, 4);
+                        p += format::null_field_size;
+                    }
+                    else {
+                        format::store_be(p, 16, 4);
+                        std::memcpy(p + 4, be.data() + 16 * k++, 16);
+                        p += format::field_size;
+                    }
+                    col = col + 1 == columns_ ? 0 : col + 1;
+                }
+            }
+            return { n, static_cast<size_t>(p - out.data()) };
+        }
+    };
+
+    // Reads PostgreSQL binary COPY data of uuid columns, e.g. from COPY t TO STDOUT (FORMAT binary).
+    // Input arrives in arbitrary pieces: read() consumes the header and the complete rows it holds,
+    // the caller carries the unconsumed tail over into the next piece.
+    class uuid_pg_copy_reader
+    {
+        using format = detail::uuid_pg_copy_format;
+
+        size_t columns_;
+        bool header_ = false;
+        bool finished_ = false;
+
+        [[noreturn]] static void invalid(const char* what) {
+            throw std::invalid_argument(std::string("fquuid:uuid_pg_copy_reader: ") + what);
+        }
+
+        // bytes of the header including its extension, 0 while incomplete
+        size_t read_header(std::span<const std::byte> in) const {
+            if (in.size() < format::header_size)
+                return 0;
+            if (std::memcmp(in.data(), format::signature.data(), format::signature.size()) != 0)
+                invalid("invalid signature");
+            auto flags = format::load_be(in.data() + 11, 4);
+            if (flags & format::flag_oids)
+                invalid("OIDs not supported");
+            if (flags & format::flags_critical)
+                invalid("unknown critical flag");
+            auto extension = format::load_be(in.data() + 15, 4);
+            if (in.size() - format::header_size < extension)
+                return 0;
+            return format::header_size + extension;
+        }
+
+        // bytes of the row at p, 0 while incomplete
+        size_t row_size(const std::byte* p, const std::byte* end) const {
+            auto q = p + 2;
+            for (size_t c = 0; c < columns_; c++) {
+                if (end - q < 4)
+                    return 0;
+                auto length = format::load_be(q, 4);
+                if (length == 0xffff'ffff) {
+                    q += format::null_field_size;
+                    continue;
+                }
+                if (length != 16)
+                    invalid("uuid field length not 16");
+                if (end - q < static_cast<std::ptrdiff_t>(format::field_size))
+                    return 0;
+                q += format::field_size;
+            }
+            return static_cast<size_t>(q - p);
+        }
+
+    public:
+        explicit uuid_pg_copy_reader(size_t columns = 1) : columns_(columns) {
+            if (columns == 0 || columns > 1600)
+                throw std::invalid_argument("fquuid:uuid_pg_copy_reader: invalid column count");
+        }
+
+        size_t columns() const noexcept { return columns_; }
+
+        // the trailer was read
+        bool finished() const noexcept { return finished_; }
+
+        // Reads complete rows from in into out, columns() values per row, at most out.size() / columns() rows.
+        // A NULL field reads as the nil uuid and sets nulls[i]; without a nulls span it is an error.
+        uuid_pg_copy_progress read(std::span<const std::byte> in, std::span<uuid> out, std::span<bool> nulls = {}) {
+            if (!nulls.empty() && nulls.size() < out.size())
+                throw std::invalid_argument("fquuid:uuid_pg_copy_reader: nulls span size insufficient");
+
+            uuid_pg_copy_progress r;
+            if (!header_) {
+                r.bytes = read_header(in);
+                if (r.bytes == 0)
+                    return r;
+                header_ = true;
+            }
+
+            // big-endian payloads gathered and converted with load_many, a run of non-NULL values at a time
+            std::array<std::byte, 16 * format::batch> be;
+            size_t run = 0;
+            auto flush = [&] {
+                load_many(std::span(be).first(16 * run), out.subspan(r.values - run, run));
+                run = 0;
+            };
+
+            auto p = in.data() + r.bytes;
+            auto end = in.data() + in.size();
+            while (!finished_ && end - p >= 2) {
+                auto fields = format::load_be(p, 2);
+                if (fields == 0xffff) {
+                    finished_ = true;
+                    p += format::trailer_size;
+                    break;
+                }
+                if (fields != columns_)
+                    invalid("unexpected field count");
+                if (out.size() - r.values < columns_)
+                    break;
+
+                // a row is at most 2 + 20 * columns bytes: check completeness only near the end of the input
+                if (static_cast<size_t>(end - p) < 2 + format::field_size * columns_ && row_size(p, end) == 0)
+                    break;
+
+                auto q = p + 2;
+                for (size_t c = 0; c < columns_; c++) {
+                    auto length = format::load_be(q, 4);
+                    if (length == 16) {
+                        std::memcpy(be.data() + 16 * run++, q + 4, 16);
+                        if (!nulls.empty())
+                            nulls[r.values] = false;
+                        r.values++;
+                        q += format::field_size;
+                        if (run == format::batch)
+                            flush();
+                        continue;
+                    }
+                    if (length != 0xffff'ffff)
+                        invalid("uuid field length not 16");
+                    if (nulls.empty())
+                        invalid("NULL without a nulls span");
+                    flush();
+                    nulls[r.values] = true;
+                    out[r.values++] = uuid{};
+                    q += format::null_field_size;
+                }
+                p = q;
+            }
+            flush();
+            r.bytes = static_cast<size_t>(p - in.data());
+            return r;
+        }
+    };
+}
@@ -0,0 +1,160 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_sort.hpp"
+
+namespace fquuid
+{
+    // Resolves abbreviated hex prefixes (git-style, "01926c01b" or "01926c01-b") to the uuids they match.
+    //
+    // The keys live in one sorted vector. A fence indexed by the leading nibbles (up to 4, about one
+    // entry per key) narrows a lookup to the keys sharing them; the rest is a binary search for the
+    // first and last key in the prefix's range.
+    class uuid_prefix_index
+    {
+        using words = std::array<uint64_t, 2>; // upper, lower
+
+        std::vector<uuid> keys_;
+        std::vector<size_t> fence_; // fence_[b]: first key whose leading nibbles are >= b
+        int fence_bits_ = 0;
+
+        // the smallest and largest uuid starting with the prefix
+        static std::pair<uuid, uuid> parse(std::string_view prefix) {
+            words lo{}, hi{};
+            size_t n = 0;
+            for (auto c : prefix) {
+                if (c == '-')
+                    continue;
+                int v = c >= '0' && c <= '9' ? c - '0'
+                      : c >= 'a' && c <= 'f' ? c - 'a' + 10
+                      : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                      : -1;
+                if (v < 0 || n == 32)
+                    throw std::invalid_argument("fquuid:uuid_prefix_index: invalid prefix");
+                auto shift = 60 - 4 * static_cast<int>(n % 16);
+                lo[n / 16] |= static_cast<uint64_t>(v) << shift;
+                n++;
+            }
+            for (size_t w = 0; w < 2; w++) {
+                auto digits = std::clamp<size_t>(n, 16 * w, 16 * w + 16) - 16 * w;
+                hi[w] = lo[w] | (digits == 16 ? 0 : ~uint64_t{0} >> (4 * digits));
+            }
+            return { std::bit_cast<uuid>(lo), std::bit_cast<uuid>(hi) };
+        }
+
+        size_t bucket(const uuid& key) const noexcept {
+            return fence_bits_ == 0 ? 0 : static_cast<size_t>(std::bit_cast<words>(key)[0] >> (64 - fence_bits_));
+        }
+
+        void build_fence() {
+            // about one fence entry per key, whole nibbles
+            fence_bits_ = std::min(16, 4 * ((static_cast<int>(std::bit_width(keys_.size())) + 3) / 4));
+            fence_.assign((size_t{1} << fence_bits_) + 1, keys_.size());
+            for (size_t i = keys_.size(); i-- > 0;)
+                fence_[bucket(keys_[i])] = i;
+            for (size_t b = fence_.size() - 1; b-- > 0;)
+                fence_[b] = std::min(fence_[b], fence_[b + 1]);
+        }
+
+        // common leading hex digits
+        static size_t common_digits(const uuid& a, const uuid& b) noexcept {
+            auto x = std::bit_cast<words>(a), y = std::bit_cast<words>(b);
+            auto zeros = x[0] != y[0] ? std::countl_zero(x[0] ^ y[0]) : 64 + std::countl_zero(x[1] ^ y[1]);
+            return static_cast<size_t>(zeros / 4);
+        }
+
+    public:
+        using value_type = uuid;
+        using size_type = size_t;
+
+        uuid_prefix_index() { build_fence(); }
+
+        // O(n) when keys are sorted, otherwise sorts them; duplicates are removed
+        explicit uuid_prefix_index(std::vector<uuid> keys) : keys_(std::move(keys)) {
+            if (!std::is_sorted(keys_.begin(), keys_.end()))
+                fquuid::sort(keys_);
+            keys_.erase(std::unique(keys_.begin(), keys_.end()), keys_.end());
+            build_fence();
+        }
+
+        explicit uuid_prefix_index(std::span<const uuid> keys)
+            : uuid_prefix_index(std::vector<uuid>(keys.begin(), keys.end())) {}
+
+        size_t size() const noexcept { return keys_.size(); }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        // every key, sorted
+        std::span<const uuid> keys() const noexcept { return keys_; }
+
+        // the keys starting with prefix, sorted; hyphens are ignored, case-insensitive
+        std::span<const uuid> find_prefix(std::string_view prefix) const {
+            auto [lo, hi] = parse(prefix);
+            auto first = keys_.begin() + static_cast<ptrdiff_t>(fence_[bucket(lo)]);
+            auto last = keys_.begin() + static_cast<ptrdiff_t>(fence_[bucket(hi) + 1]);
+            first = std::lower_bound(first, last, lo);
+            last = std::upper_bound(first, last, hi);
+            return { first, last };
+        }
+
+        // the only key starting with prefix, nullopt when none or several do;
+        // find_prefix(prefix).size() tells the two apart
+        std::optional<uuid> resolve(std::string_view prefix) const {
+            auto m = find_prefix(prefix);
+            if (m.size() != 1)
+                return std::nullopt;
+            return m[0];
+        }
+
+        // hex digits in the shortest prefix of keys()[i] matching no other key
+        size_t shortest_unique_prefix(size_t i) const {
+            if (i >= keys_.size())
+                throw std::out_of_range("fquuid:uuid_prefix_index: index out of range");
+            size_t n = 0;
+            if (i > 0)
+                n = common_digits(keys_[i - 1], keys_[i]);
+            if (i + 1 < keys_.size())
+                n = std::max(n, common_digits(keys_[i], keys_[i + 1]));
+            return std::min<size_t>(n + 1, 32);
+        }
+
+        size_t shortest_unique_prefix(const uuid& key) const {
+            auto it = std::lower_bound(keys_.begin(), keys_.end(), key);
+            if (it == keys_.end() || *it != key)
+                throw std::out_of_range("fquuid:uuid_prefix_index: key not found");
+            return shortest_unique_prefix(static_cast<size_t>(it - keys_.begin()));
+        }
+
+        // shortest_unique_prefix(i) for every key in one pass
+        std::vector<uint8_t> shortest_unique_prefixes() const {
+            std::vector<uint8_t> v(keys_.size(), 1);
+            for (size_t i = 1; i < keys_.size(); i++) {
+                auto n = static_cast<uint8_t>(std::min<size_t>(common_digits(keys_[i - 1], keys_[i]) + 1, 32));
+                v[i - 1] = std::max(v[i - 1], n);
+                v[i] = n;
+            }
+            return v;
+        }
+
+        // the key in the standard format, cut after its shortest unique prefix but at least min_digits hex digits
+        std::string abbreviate(const uuid& key, size_t min_digits = 0) const {
+            auto digits = std::min<size_t>(32, std::max<size_t>(shortest_unique_prefix(key), min_digits));
+            auto s = key.to_chars();
+            // hyphens follow hex digits 8, 12, 16 and 20
+            auto chars = digits + (digits > 8) + (digits > 12) + (digits > 16) + (digits > 20);
+            return std::string(s.data(), chars);
+        }
+    };
+}
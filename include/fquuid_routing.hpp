@@ -0,0 +1,427 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_hash.hpp"
+#include "fquuid_simd.hpp"
+
+// Routing of uuid keys onto shards or nodes.
+//
+// Hash selects the key bits that decide the route, as for the hash containers:
+// uuid_hash mixes every bit, uuid_v7_random_hash routes v7 keys by their random bits only,
+// so keys generated in the same moment spread like any others and a route never depends on time.
+// route_many hashes a batch of keys up front, then routes the whole batch at once.
+
+namespace fquuid::detail
+{
+    struct uuid_routing
+    {
+        static constexpr size_t batch_size = 64;
+
+        // murmur3 finalizer, a bijection on 64 bits
+        static constexpr uint64_t fmix64(uint64_t h) noexcept {
+            h ^= h >> 33;
+            h *= 0xff51'afd7'ed55'8ccd;
+            h ^= h >> 33;
+            h *= 0xc4ce'b9fe'1a85'ec53;
+            h ^= h >> 33;
+            return h;
+        }
+
+        static void check_output(size_t keys, size_t out) {
+            if (out < keys)
+                throw std::invalid_argument("fquuid:route_many: output span size insufficient");
+        }
+
+        static void check_nodes(size_t nodes, const char* what) {
+            if (nodes == 0 || nodes > std::numeric_limits<uint32_t>::max())
+                throw std::invalid_argument(what);
+        }
+
+        // node ids 0 .. count-1
+        static std::vector<uint64_t> iota(size_t count) {
+            std::vector<uint64_t> ids(count);
+            for (size_t i = 0; i < count; i++)
+                ids[i] = i;
+            return ids;
+        }
+
+        // a node's score seeds and ring points derive from its id
+        static uint64_t node_seed(uint64_t id) noexcept {
+            return fmix64(~id);
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Jump consistent hash (Lamping, Veach 2014): shards 0 .. N-1 without any table.
+    // Growing N to N+1 moves 1/(N+1) of the keys, all onto the new shard;
+    // only the last shard can be taken away.
+    template <class Hash = uuid_hash>
+    class uuid_basic_jump_router
+    {
+        using routing = detail::uuid_routing;
+
+        static constexpr uint64_t lcg = 2862933555777941757;
+
+        uint32_t shards_;
+        [[no_unique_address]] Hash hash_;
+
+#if defined(FQUUID_SIMD_AVX2)
+        static __m256i next_avx2(__m256i h) noexcept {
+            auto lo = _mm256_set1_epi64x(static_cast<int64_t>(lcg & 0xffff'ffff));
+            auto hi = _mm256_set1_epi64x(static_cast<int64_t>(lcg >> 32));
+            auto cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(h, 32), lo), _mm256_mul_epu32(h, hi));
+            return _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(h, lo), _mm256_slli_epi64(cross, 32)), _mm256_set1_epi64x(1));
+        }
+
+        // jump() on 8 keys, two vectors of 4 lanes stepping until every lane settles.
+        // Jump targets stay doubles: a lane goes on while its target is below the shard count,
+        // its shard is the target truncated, so lanes match jump() exactly. Needs shards < 2^31.
+        static void jump_avx2(const uint64_t* h, uint32_t* out, uint32_t shards) noexcept {
+            auto n = _mm256_set1_pd(static_cast<double>(shards));
+            // (h >> 33) to double through the exponent of 2^52
+            auto magic = _mm256_set1_epi64x(0x4330'0000'0000'0000);
+            auto magic_d = _mm256_set1_pd(4503599627370496.0);
+            auto one = _mm256_set1_pd(1.0);
+            auto scale = _mm256_set1_pd(2147483648.0);
+
+            __m256i key[2];
+            __m256d from[2], to[2];
+            for (int v = 0; v < 2; v++) {
+                key[v] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + 4 * v));
+                from[v] = _mm256_set1_pd(-1.0);
+                to[v] = _mm256_setzero_pd();
+            }
+            for (int active = 1; active != 0;) {
+                active = 0;
+                for (int v = 0; v < 2; v++) {
+                    auto jumping = _mm256_cmp_pd(to[v], n, _CMP_LT_OQ);
+                    active |= _mm256_movemask_pd(jumping);
+                    key[v] = next_avx2(key[v]);
+                    auto x = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(key[v], 33), magic)), magic_d);
+                    auto r = _mm256_div_pd(scale, _mm256_add_pd(x, one));
+                    from[v] = _mm256_blendv_pd(from[v], _mm256_floor_pd(to[v]), jumping);
+                    to[v] = _mm256_blendv_pd(to[v], _mm256_mul_pd(_mm256_add_pd(from[v], one), r), jumping);
+                }
+            }
+            for (int v = 0; v < 2; v++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * v), _mm256_cvttpd_epi32(from[v]));
+        }
+#endif
+
+    public:
+        using hasher = Hash;
+
+        explicit uuid_basic_jump_router(uint32_t shards, const Hash& hash = Hash()) : shards_(shards), hash_(hash) {
+            routing::check_nodes(shards, "fquuid:uuid_jump_router: invalid shard count");
+        }
+
+        uint32_t shard_count() const noexcept { return shards_; }
+
+        static uint32_t jump(uint64_t h, uint32_t shards) noexcept {
+            int64_t b = -1, j = 0;
+            while (j < shards) {
+                b = j;
+                h = h * lcg + 1;
+                j = static_cast<int64_t>(static_cast<double>(b + 1) * (static_cast<double>(int64_t{1} << 31) / static_cast<double>((h >> 33) + 1)));
+            }
+            return static_cast<uint32_t>(b);
+        }
+
+        uint32_t route(const uuid& key) const noexcept {
+            return jump(static_cast<uint64_t>(hash_(key)), shards_);
+        }
+
+        // out[i] = route(keys[i])
+        void route_many(std::span<const uuid> keys, std::span<uint32_t> out) const {
+            routing::check_output(keys.size(), out.size());
+
+            std::array<uint64_t, routing::batch_size> h;
+            for (size_t b = 0; b < keys.size(); b += h.size()) {
+                auto m = std::min(h.size(), keys.size() - b);
+                for (size_t j = 0; j < m; j++)
+                    h[j] = static_cast<uint64_t>(hash_(keys[b + j]));
+
+                size_t j = 0;
+#if defined(FQUUID_SIMD_AVX2)
+                if (shards_ <= std::numeric_limits<int32_t>::max()) {
+                    for (; j + 8 <= m; j += 8)
+                        jump_avx2(&h[j], &out[b + j], shards_);
+                }
+#endif
+                for (; j < m; j++)
+                    out[b + j] = jump(h[j], shards_);
+            }
+        }
+    };
+
+    // Rendezvous (highest random weight) hashing over nodes named by 64-bit ids.
+    // A key goes to the node scoring highest for it; adding or removing a node moves
+    // only the keys that node wins or held. O(nodes) per key, for up to a few hundred nodes.
+    //
+    // A node scores a key as the murmur3 32-bit finalizer of the folded key hash xor the node seed:
+    // 32-bit lanes, so AVX2 scores 8 keys per instruction.
+    template <class Hash = uuid_hash>
+    class uuid_basic_rendezvous_router
+    {
+        using routing = detail::uuid_routing;
+
+        std::vector<uint64_t> nodes_;
+        std::vector<uint32_t> seeds_;
+        [[no_unique_address]] Hash hash_;
+
+        static uint32_t fold(uint64_t h) noexcept {
+            return static_cast<uint32_t>(h ^ (h >> 32));
+        }
+
+        static uint32_t score(uint32_t h, uint32_t seed) noexcept {
+            auto x = h ^ seed;
+            x ^= x >> 16;
+            x *= 0x85eb'ca6b;
+            x ^= x >> 13;
+            x *= 0xc2b2'ae35;
+            x ^= x >> 16;
+            return x;
+        }
+
+        uint32_t route_hash(uint32_t h) const noexcept {
+            uint32_t best = 0;
+            uint32_t node = 0;
+            for (size_t i = 0; i < seeds_.size(); i++) {
+                auto s = score(h, seeds_[i]);
+                if (s > best) {
+                    best = s;
+                    node = static_cast<uint32_t>(i);
+                }
+            }
+            return node;
+        }
+
+    public:
+        using hasher = Hash;
+
+        // route() returns an index into nodes
+        explicit uuid_basic_rendezvous_router(std::span<const uint64_t> nodes, const Hash& hash = Hash())
+            : nodes_(nodes.begin(), nodes.end()), hash_(hash) {
+            routing::check_nodes(nodes.size(), "fquuid:uuid_rendezvous_router: invalid node count");
+            for (auto id : nodes_)
+                seeds_.push_back(static_cast<uint32_t>(routing::node_seed(id)));
+        }
+
+        // nodes 0 .. count-1
+        explicit uuid_basic_rendezvous_router(size_t count, const Hash& hash = Hash())
+            : uuid_basic_rendezvous_router(routing::iota(count), hash) {}
+
+        size_t node_count() const noexcept { return nodes_.size(); }
+        std::span<const uint64_t> nodes() const noexcept { return nodes_; }
+
+        uint32_t route(const uuid& key) const noexcept {
+            return route_hash(fold(static_cast<uint64_t>(hash_(key))));
+        }
+
+        // out[i] = route(keys[i]).
+        // With AVX2 the nodes go outside and the keys of a batch inside, a branch-free loop that vectorizes.
+        void route_many(std::span<const uuid> keys, std::span<uint32_t> out) const {
+            routing::check_output(keys.size(), out.size());
+
+            std::array<uint32_t, routing::batch_size> h{};
+#if defined(FQUUID_SIMD_AVX2)
+            constexpr size_t lanes = 16;
+#endif
+            for (size_t b = 0; b < keys.size(); b += h.size()) {
+                auto m = std::min(h.size(), keys.size() - b);
+                for (size_t j = 0; j < m; j++)
+                    h[j] = fold(static_cast<uint64_t>(hash_(keys[b + j])));
+#if defined(FQUUID_SIMD_AVX2)
+                // 16 keys at a time keep their best scores in registers while the nodes go by
+                for (size_t k = 0; k < m; k += lanes) {
+                    std::array<uint32_t, lanes> best{}, node{};
+                    for (size_t i = 0; i < seeds_.size(); i++) {
+                        auto seed = seeds_[i];
+                        for (size_t j = 0; j < lanes; j++) {
+                            auto s = score(h[k + j], seed);
+                            node[j] = s > best[j] ? static_cast<uint32_t>(i) : node[j];
+                            best[j] = std::max(s, best[j]);
+                        }
+                    }
+                    std::copy_n(node.begin(), std::min(lanes, m - k), out.begin() + static_cast<ptrdiff_t>(b + k));
+                }
+#else
+                for (size_t j = 0; j < m; j++)
+                    out[b + j] = route_hash(h[j]);
+#endif
+            }
+        }
+    };
+
+    // Consistent hashing with bounded loads (Mirrokni, Thorup, Zadimoghaddam 2018).
+    // Each node owns virtual points on a 64-bit ring; a key goes to the first node clockwise
+    // from its hash whose load stays within capacity() = ceil((1 + epsilon) * (total_load() + 1) / nodes),
+    // so no node carries more than (1 + epsilon) times the average.
+    // Loads are counted by assign() and release(), which need external synchronization; the points never change.
+    template <class Hash = uuid_hash>
+    class uuid_basic_bounded_load_ring
+    {
+        using routing = detail::uuid_routing;
+
+        std::vector<uint64_t> points_; // sorted
+        std::vector<uint32_t> owners_; // owners_[i]: node of points_[i]
+        std::vector<uint64_t> nodes_;
+        std::vector<uint64_t> loads_;
+        uint64_t total_load_ = 0;
+        double epsilon_;
+        [[no_unique_address]] Hash hash_;
+
+        // out[j]: first point at or after h[j], wrapping to 0.
+        // The searches run level by level so their cache misses overlap.
+        void first_points(std::span<const uint64_t> h, std::span<size_t> out) const noexcept {
+            std::array<const uint64_t*, routing::batch_size> p;
+            auto m = h.size();
+            std::fill_n(p.begin(), m, points_.data());
+            for (size_t n = points_.size(); n > 1; n -= n / 2) {
+                auto half = n / 2;
+                for (size_t j = 0; j < m; j++) {
+                    p[j] += (p[j][half - 1] < h[j]) * half;
+                    detail::prefetch(p[j] + (n - half) / 2);
+                }
+            }
+            for (size_t j = 0; j < m; j++) {
+                auto i = static_cast<size_t>(p[j] - points_.data()) + (*p[j] < h[j]);
+                out[j] = i == points_.size() ? 0 : i;
+            }
+        }
+
+        // the first node from point i on with room for one more key
+        uint32_t walk(size_t i) const noexcept {
+            auto cap = capacity();
+            while (loads_[owners_[i]] >= cap)
+                i = i + 1 == points_.size() ? 0 : i + 1;
+            return owners_[i];
+        }
+
+    public:
+        using hasher = Hash;
+
+        // route() returns an index into nodes
+        explicit uuid_basic_bounded_load_ring(std::span<const uint64_t> nodes, size_t points_per_node = 128, double epsilon = 0.25, const Hash& hash = Hash())
+            : nodes_(nodes.begin(), nodes.end()), loads_(nodes.size()), epsilon_(epsilon), hash_(hash) {
+            routing::check_nodes(nodes.size(), "fquuid:uuid_bounded_load_ring: invalid node count");
+            if (points_per_node == 0 || !(epsilon > 0))
+                throw std::invalid_argument("fquuid:uuid_bounded_load_ring: invalid argument");
+
+            std::vector<std::pair<uint64_t, uint32_t>> ring;
+            ring.reserve(nodes.size() * points_per_node);
+            for (size_t i = 0; i < nodes.size(); i++) {
+                auto seed = routing::node_seed(nodes[i]);
+                for (size_t v = 0; v < points_per_node; v++)
+                    ring.emplace_back(routing::fmix64(seed + v), static_cast<uint32_t>(i));
+            }
+            std::sort(ring.begin(), ring.end());
+            for (auto [point, node] : ring) {
+                points_.push_back(point);
+                owners_.push_back(node);
+            }
+        }
+
+        // nodes 0 .. count-1
+        explicit uuid_basic_bounded_load_ring(size_t count, size_t points_per_node = 128, double epsilon = 0.25, const Hash& hash = Hash())
+            : uuid_basic_bounded_load_ring(routing::iota(count), points_per_node, epsilon, hash) {}
+
+        size_t node_count() const noexcept { return nodes_.size(); }
+        std::span<const uint64_t> nodes() const noexcept { return nodes_; }
+        double epsilon() const noexcept { return epsilon_; }
+
+        uint64_t load(uint32_t node) const { return loads_.at(node); }
+        uint64_t total_load() const noexcept { return total_load_; }
+
+        // the most keys a node may hold once one more key is assigned
+        uint64_t capacity() const noexcept {
+            auto average = static_cast<double>(total_load_ + 1) / static_cast<double>(nodes_.size());
+            return static_cast<uint64_t>(std::ceil((1 + epsilon_) * average));
+        }
+
+        // the node assign(key) would choose under the current loads
+        uint32_t route(const uuid& key) const noexcept {
+            auto h = static_cast<uint64_t>(hash_(key));
+            size_t i;
+            first_points(std::span(&h, 1), std::span(&i, 1));
+            return walk(i);
+        }
+
+        // route(key), counting the key on its node
+        uint32_t assign(const uuid& key) noexcept {
+            auto node = route(key);
+            loads_[node]++;
+            total_load_++;
+            return node;
+        }
+
+        // forgets a key assign() put on node
+        void release(uint32_t node) {
+            if (node >= loads_.size() || loads_[node] == 0)
+                throw std::invalid_argument("fquuid:uuid_bounded_load_ring: node has no load");
+            loads_[node]--;
+            total_load_--;
+        }
+
+        void clear_loads() noexcept {
+            std::fill(loads_.begin(), loads_.end(), 0);
+            total_load_ = 0;
+        }
+
+        // out[i] = route(keys[i]) under the current loads
+        void route_many(std::span<const uuid> keys, std::span<uint32_t> out) const {
+            routing::check_output(keys.size(), out.size());
+
+            std::array<uint64_t, routing::batch_size> h;
+            std::array<size_t, routing::batch_size> first;
+            for (size_t b = 0; b < keys.size(); b += h.size()) {
+                auto m = std::min(h.size(), keys.size() - b);
+                for (size_t j = 0; j < m; j++)
+                    h[j] = static_cast<uint64_t>(hash_(keys[b + j]));
+                first_points(std::span(h).first(m), first);
+                for (size_t j = 0; j < m; j++)
+                    out[b + j] = walk(first[j]);
+            }
+        }
+
+        // out[i] = assign(keys[i]); the ring is searched in batches, the walks see every earlier assignment
+        void assign_many(std::span<const uuid> keys, std::span<uint32_t> out) {
+            routing::check_output(keys.size(), out.size());
+
+            std::array<uint64_t, routing::batch_size> h;
+            std::array<size_t, routing::batch_size> first;
+            for (size_t b = 0; b < keys.size(); b += h.size()) {
+                auto m = std::min(h.size(), keys.size() - b);
+                for (size_t j = 0; j < m; j++)
+                    h[j] = static_cast<uint64_t>(hash_(keys[b + j]));
+                first_points(std::span(h).first(m), first);
+                for (size_t j = 0; j < m; j++) {
+                    auto node = walk(first[j]);
+                    loads_[node]++;
+                    total_load_++;
+                    out[b + j] = node;
+                }
+            }
+        }
+    };
+
+    using uuid_jump_router = uuid_basic_jump_router<>;
+    using uuid_v7_jump_router = uuid_basic_jump_router<uuid_v7_random_hash>;
+    using uuid_rendezvous_router = uuid_basic_rendezvous_router<>;
+    using uuid_v7_rendezvous_router = uuid_basic_rendezvous_router<uuid_v7_random_hash>;
+    using uuid_bounded_load_ring = uuid_basic_bounded_load_ring<>;
+    using uuid_v7_bounded_load_ring = uuid_basic_bounded_load_ring<uuid_v7_random_hash>;
+}
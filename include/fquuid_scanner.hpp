@@ -0,0 +1,354 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+#include "fquuid_uuid.hpp"
+#include "fquuid_simd.hpp"
+
+namespace fquuid
+{
+    enum class scan_mode : unsigned
+    {
+        standard = 0,       // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+        hex32 = 1 << 0,     // also xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+        braced = 1 << 1,    // include surrounding {} in the match
+    };
+
+    constexpr scan_mode operator |(scan_mode a, scan_mode b) noexcept {
+        return static_cast<scan_mode>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+    }
+
+    struct uuid_match
+    {
+        size_t offset;
+        size_t length;
+        uuid value;
+    };
+}
+
+namespace fquuid::detail
+{
+    class uuid_scanner
+    {
+        struct bits128
+        {
+            uint64_t lo, hi;
+
+            constexpr bits128 operator >>(int n) const noexcept {
+                return { (lo >> n) | (hi << (64 - n)), hi >> n };
+            }
+
+            constexpr bits128 operator &(const bits128& r) const noexcept {
+                return { lo & r.lo, hi & r.hi };
+            }
+        };
+
+        // bit i: text[pos + i] is '-' / [0-9A-Fa-f], hex only with hex32_
+        struct char_masks
+        {
+            uint64_t dash;
+            uint64_t hex;
+        };
+
+        std::span<const char> text_;
+        bool hex32_;
+        bool braced_;
+
+        static constexpr bool is_hex(char c) noexcept {
+            return ((c >= '0' && c <= '9') ||
+                    (c >= 'a' && c <= 'f') ||
+                    (c >= 'A' && c <= 'F'));
+        }
+
+        char_masks load_masks(size_t pos) const noexcept {
+#if defined(FQUUID_SIMD_AVX2)
+            if (pos + 64 <= text_.size()) {
+                auto p = text_.data() + pos;
+                uint64_t dash = 0, hex = 0;
+                for (int i = 0; i < 2; i++) {
+                    auto c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 32 * i));
+                    auto d = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('-'));
+                    dash |= static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(d))) << (32 * i);
+                    if (!hex32_)
+                        continue;
+                    auto lc = _mm256_or_si256(c, _mm256_set1_epi8(0x20));
+                    auto digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                                  _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+                    auto alpha = _mm256_and_si256(_mm256_cmpgt_epi8(lc, _mm256_set1_epi8('a' - 1)),
+                                                  _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lc));
+                    hex |= static_cast<uint64_t>(static_cast<uint32_t>(
+                        _mm256_movemask_epi8(_mm256_or_si256(digit, alpha)))) << (32 * i);
+                }
+                return { dash, hex };
+            }
+#elif defined(FQUUID_SIMD_SSE2)
+            if (pos + 64 <= text_.size()) {
+                auto p = text_.data() + pos;
+                uint64_t dash = 0, hex = 0;
+                for (int i = 0; i < 4; i++) {
+                    auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16 * i));
+                    auto d = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+                    dash |= static_cast<uint64_t>(_mm_movemask_epi8(d)) << (16 * i);
+                    if (!hex32_)
+                        continue;
+                    auto lc = _mm_or_si128(c, _mm_set1_epi8(0x20));
+                    auto h = _mm_or_si128(sse2_in_range(c, '0', '9'), sse2_in_range(lc, 'a', 'f'));
+                    hex |= static_cast<uint64_t>(_mm_movemask_epi8(h)) << (16 * i);
+                }
+                return { dash, hex };
+            }
+#endif
+
+            char_masks m { 0, 0 };
+            for (size_t i = 0; i < 64 && pos + i < text_.size(); i++) {
+                auto c = text_[pos + i];
+                m.dash |= static_cast<uint64_t>(c == '-') << i;
+                m.hex |= static_cast<uint64_t>(is_hex(c)) << i;
+            }
+            return m;
+        }
+
+        bool is_boundary(size_t begin, size_t end) const noexcept {
+            return ((begin == 0 || !is_hex(text_[begin - 1])) &&
+                    (end == text_.size() || !is_hex(text_[end])));
+        }
+
+        template <size_t Length>
+        bool try_match(size_t begin, uuid_match& m) const noexcept {
+            if (begin + Length > text_.size() || !is_boundary(begin, begin + Length))
+                return false;
+
+            auto s = text_.subspan(begin).template first<Length>();
+            uuid_u128 u {};
+            if constexpr (Length == 36) {
+                if (!uuid_string::try_parse_standard(u, s))
+                    return false;
+            } else {
+                if (!uuid_string::try_parse_hex(u, s))
+                    return false;
+            }
+
+            m = { begin, Length, uuid{u} };
+            if (braced_ && begin > 0 && begin + Length < text_.size() &&
+                text_[begin - 1] == '{' && text_[begin + Length] == '}') {
+                m.offset -= 1;
+                m.length += 2;
+            }
+            return true;
+        }
+
+    public:
+        uuid_scanner(std::span<const char> text, scan_mode mode) noexcept
+            : text_(text),
+              hex32_(static_cast<unsigned>(mode) & static_cast<unsigned>(scan_mode::hex32)),
+              braced_(static_cast<unsigned>(mode) & static_cast<unsigned>(scan_mode::braced)) {}
+
+        // fn(const uuid_match&) may return false to stop scanning
+        template <class Fn>
+        void scan(Fn& fn) const {
+            size_t resume = 0; // matches never overlap
+            auto cur = load_masks(0);
+
+            for (size_t pos = 0; pos < text_.size(); pos += 64) {
+                auto next = load_masks(pos + 64);
+
+                // dashes at +8, +13, +18 and +23
+                auto dash = bits128 { cur.dash, next.dash };
+                uint64_t standard = ((dash >> 8) & (dash >> 13) & (dash >> 18) & (dash >> 23)).lo;
+
+                // 32 consecutive hexadecimal digits
+                uint64_t hex32 = 0;
+                if (hex32_) {
+                    auto run = bits128 { cur.hex, next.hex };
+                    run = run & (run >> 1);
+                    run = run & (run >> 2);
+                    run = run & (run >> 4);
+                    run = run & (run >> 8);
+                    run = run & (run >> 16);
+                    hex32 = run.lo;
+                }
+
+                for (auto candidates = standard | hex32; candidates != 0; candidates &= candidates - 1) {
+                    auto i = std::countr_zero(candidates);
+                    auto begin = pos + i;
+                    if (begin < resume)
+                        continue;
+
+                    uuid_match m;
+                    bool found = (((standard >> i) & 1) && try_match<36>(begin, m)) ||
+                                 (((hex32 >> i) & 1) && try_match<32>(begin, m));
+                    if (!found)
+                        continue;
+
+                    resume = m.offset + m.length;
+                    if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const uuid_match&>, bool>) {
+                        if (!fn(m))
+                            return;
+                    } else {
+                        fn(m);
+                    }
+                }
+
+                cur = next;
+            }
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Finds every UUID in text that is not part of a longer run of hexadecimal digits.
+    // Validation follows uuid_basic_string::parse.
+    template <std::invocable<const uuid_match&> Callback>
+    void scan_uuids(std::span<const char> text, Callback&& cb, scan_mode mode = scan_mode::standard) {
+        detail::uuid_scanner(text, mode).scan(cb);
+    }
+
+    // Stores up to out.size() matches and returns the count.
+    // When out is full, resume from the end of the last match.
+    inline size_t scan_uuids(std::span<const char> text, std::span<uuid_match> out,
+                             scan_mode mode = scan_mode::standard) {
+        size_t count = 0;
+        if (out.empty())
+            return count;
+
+        auto fn = [&](const uuid_match& m) {
+            out[count++] = m;
+            return count < out.size();
+        };
+        detail::uuid_scanner(text, mode).scan(fn);
+        return count;
+    }
+
+    // Finds UUIDs as scan_uuids does in text arriving in pieces, e.g. socket reads or file chunks,
+    // where a UUID may straddle two pieces. Offsets count from the start of the stream.
+    // Like scan_uuids it is a scanner, not a parser: malformed UUIDs and UUIDs run together with
+    // other hexadecimal digits are skipped without an error.
+    //
+    // A callback returning bool stops the scan with false: feed() then skips the rest of the piece
+    // and returns false. The piece is still consumed, so later offsets stay right, and the matches
+    // skipped in it are never reported.
+    //
+    // Each piece is scanned in place. Only the boundary fragment, the last few characters where a
+    // match may still begin, is carried over and stitched to the head of the next piece.
+    class uuid_stream_scanner
+    {
+        // a match and the characters around it: 1 + 36 + 1, or '{' + 36 + '}'
+        static constexpr size_t window = 38;
+        static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+        scan_mode mode_;
+        size_t pos_ = 0;     // characters fed so far
+        size_t settled_ = 0; // every match beginning before this was reported
+        size_t resume_ = 0;  // matches never overlap
+        size_t tail_ = 0;    // buf_[0, tail_) holds the stream from base()
+        std::array<char, 2 * window> buf_;
+
+        // the unsettled characters and the one before them
+        size_t base() const noexcept { return settled_ == 0 ? 0 : settled_ - 1; }
+
+        // Reports the matches in text (at stream offset offset) beginning in [first, last),
+        // false when fn stopped the scan.
+        // Unless text ends the stream, a match needs the character after it to be known.
+        template <class Fn>
+        bool scan(std::span<const char> text, size_t offset, size_t first, size_t last, bool end, Fn& fn) {
+            bool go = true;
+            auto report = [&](const uuid_match& m) {
+                auto braced = m.length % 4 == 2; // 34 or 38
+                auto begin = offset + m.offset + braced;
+                if (begin < first || begin >= last || begin < resume_)
+                    return true;
+                if (!end && m.offset + m.length - braced == text.size())
+                    return true;
+                auto r = uuid_match { offset + m.offset, m.length, m.value };
+                resume_ = r.offset + r.length;
+                if constexpr (std::is_same_v<std::invoke_result_t<Fn&, const uuid_match&>, bool>)
+                    go = fn(r);
+                else
+                    fn(r);
+                return go;
+            };
+            detail::uuid_scanner(text, mode_).scan(report);
+            return go;
+        }
+
+    public:
+        explicit uuid_stream_scanner(scan_mode mode = scan_mode::standard) noexcept : mode_(mode) {}
+
+        // characters fed since construction or reset()
+        size_t position() const noexcept { return pos_; }
+
+        template <std::invocable<const uuid_match&> Callback>
+        bool feed(std::span<const char> text, Callback&& cb) {
+            if (text.empty())
+                return true;
+
+            // matches beginning in the carried fragment or at text[0], stitched to the head of text
+            auto offset = base();
+            auto head = std::min(text.size(), window);
+            std::memcpy(buf_.data() + tail_, text.data(), head);
+            bool go = scan(std::span<const char>(buf_.data(), tail_ + head), offset, settled_, pos_ + 1, false, cb);
+
+            // the rest in place, where every candidate has the character before it
+            go = go && scan(text, pos_, pos_ + 1, none, false, cb);
+
+            // a match beginning before the last 37 characters is complete with the character after it,
+            // after a stop none beginning in the piece is reported any more
+            pos_ += text.size();
+            settled_ = go ? std::max({ settled_, resume_, pos_ - std::min<size_t>(pos_, window - 1) }) : pos_;
+            auto b = base();
+            if (b >= pos_ - text.size())
+                std::memcpy(buf_.data(), text.data() + (b - (pos_ - text.size())), pos_ - b);
+            else // text shorter than the window, entirely in buf_
+                std::memmove(buf_.data(), buf_.data() + (b - offset), pos_ - b);
+            tail_ = pos_ - b;
+            return go;
+        }
+
+        // scatter-gather input, fed in order; a stop leaves the remaining buffers unfed
+        template <std::invocable<const uuid_match&> Callback>
+        bool feed(std::span<const std::span<const char>> buffers, Callback&& cb) {
+            for (auto& b : buffers) {
+                if (!feed(b, cb))
+                    return false;
+            }
+            return true;
+        }
+
+#ifndef _WIN32
+        template <std::invocable<const uuid_match&> Callback>
+        bool feed(std::span<const iovec> buffers, Callback&& cb) {
+            for (auto& b : buffers) {
+                if (!feed(std::span<const char>(static_cast<const char*>(b.iov_base), b.iov_len), cb))
+                    return false;
+            }
+            return true;
+        }
+#endif
+
+        // Ends the stream: reports a match at its very end, then starts over as reset() does
+        template <std::invocable<const uuid_match&> Callback>
+        bool finish(Callback&& cb) {
+            bool go = scan(std::span<const char>(buf_.data(), tail_), base(), settled_, none, true, cb);
+            reset();
+            return go;
+        }
+
+        // Discards the carried fragment and starts a new stream at offset 0
+        void reset() noexcept {
+            pos_ = settled_ = resume_ = tail_ = 0;
+        }
+    };
+}
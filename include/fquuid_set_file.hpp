@@ -0,0 +1,419 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_bulk.hpp"
+#include "fquuid_mmap.hpp"
+#include "fquuid_sort.hpp"
+#include "fquuid_view.hpp"
+
+// Sorted uuid set file
+//
+//   offset  size
+//        0     8  magic "FQUUIDS1"
+//        8     4  format version (1)
+//       12     4  block: keys per fence entry
+//       16     8  key count
+//       24     8  fence count = ceil(key count / block)
+//       32     8  key offset (64)
+//       40     8  fence offset = 64 + key count * 16
+//       48    16  reserved (0)
+//       64        keys: sorted, distinct 16-byte big-endian records
+//                 fence: keys[i * block], 16-byte records
+//
+// Header integers are little-endian.
+
+namespace fquuid::detail
+{
+    struct uuid_set_file_format
+    {
+        static constexpr std::array<char, 8> magic { 'F', 'Q', 'U', 'U', 'I', 'D', 'S', '1' };
+        static constexpr uint32_t version = 1;
+        static constexpr size_t header_size = 64;
+
+        // 256 keys = one 4 KiB page, so a lookup touches the fence and one page of keys
+        static constexpr uint32_t default_block = 256;
+    };
+
+    struct uuid_file_closer
+    {
+        void operator ()(std::FILE* f) const noexcept { std::fclose(f); }
+    };
+
+    using uuid_file_ptr = std::unique_ptr<std::FILE, uuid_file_closer>;
+
+    inline uuid_file_ptr open_file(const std::filesystem::path& path, const char* mode) {
+        uuid_file_ptr f{std::fopen(path.string().c_str(), mode)};
+        if (!f)
+            throw std::runtime_error("fquuid:uuid_set_file_writer: can't open file");
+        return f;
+    }
+
+    inline void write_file(std::FILE* f, const void* p, size_t size) {
+        if (std::fwrite(p, 1, size, f) != size)
+            throw std::runtime_error("fquuid:uuid_set_file_writer: write error");
+    }
+
+    // fclose reports buffered write errors
+    inline void close_file(uuid_file_ptr& f) {
+        if (std::fclose(f.release()) != 0)
+            throw std::runtime_error("fquuid:uuid_set_file_writer: write error");
+    }
+
+    inline void sync_file(uuid_file_ptr& f) {
+        if (!detail::sync_file(f.get()))
+            throw std::runtime_error("fquuid:uuid_set_file_writer: write error");
+    }
+
+    // Buffered 16-byte big-endian records
+    class uuid_record_writer
+    {
+        static constexpr size_t buffer_keys = 4096;
+
+        std::FILE* file_;
+        std::vector<uuid> keys_;
+        std::vector<std::byte> bytes_;
+
+    public:
+        explicit uuid_record_writer(std::FILE* file) : file_(file), bytes_(buffer_keys * 16) {
+            keys_.reserve(buffer_keys);
+        }
+
+        void push(const uuid& u) {
+            keys_.push_back(u);
+            if (keys_.size() == buffer_keys)
+                flush();
+        }
+
+        void flush() {
+            auto n = store_many(keys_, bytes_);
+            write_file(file_, bytes_.data(), n);
+            keys_.clear();
+        }
+    };
+
+    class uuid_record_reader
+    {
+        static constexpr size_t buffer_keys = 4096;
+
+        uuid_file_ptr file_;
+        std::vector<uuid> keys_;
+        std::vector<std::byte> bytes_;
+        size_t pos_ = 0;
+
+    public:
+        explicit uuid_record_reader(const std::filesystem::path& path)
+            : file_(open_file(path, "rb")), bytes_(buffer_keys * 16) {
+            keys_.reserve(buffer_keys);
+        }
+
+        bool next(uuid& u) {
+            if (pos_ == keys_.size()) {
+                auto n = std::fread(bytes_.data(), 16, buffer_keys, file_.get());
+                if (n == 0)
+                    return false;
+                keys_.resize(n);
+                load_many(std::span<const std::byte>(bytes_).first(n * 16), keys_);
+                pos_ = 0;
+            }
+            u = keys_[pos_++];
+            return true;
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Read-only, memory-mapped sorted uuid set file.
+    // Opening maps the file and checks the header; pages are read on demand by the OS.
+    class uuid_set_file
+    {
+        using format = detail::uuid_set_file_format;
+
+        detail::uuid_mapped_file file_;
+        std::span<const std::byte> keys_;
+        std::span<const std::byte> fence_;
+        size_t block_ = format::default_block;
+
+        static const std::byte* record(std::span<const std::byte> records, size_t i) noexcept {
+            return records.data() + i * 16;
+        }
+
+        // first record in [first, last) not less than key,
+        // records are loaded as words (two byte swaps) rather than compared with memcmp
+        static size_t lower_bound(std::span<const std::byte> records, size_t first, size_t last, const uuid& key) noexcept {
+            while (first < last) {
+                auto mid = first + (last - first) / 2;
+                if (uuid::from_bytes<layout::big_endian>(std::span<const std::byte>(record(records, mid), 16)) < key)
+                    first = mid + 1;
+                else
+                    last = mid;
+            }
+            return first;
+        }
+
+        static std::runtime_error format_error() {
+            return std::runtime_error("fquuid:uuid_set_file: invalid file format");
+        }
+
+    public:
+        explicit uuid_set_file(const std::filesystem::path& path) : file_(path) {
+            auto bytes = file_.bytes();
+            if (bytes.size() < format::header_size
+                || !std::equal(format::magic.begin(), format::magic.end(), bytes.begin(),
+                               [](char c, std::byte b) { return static_cast<std::byte>(c) == b; }))
+                throw format_error();
+
+            auto h = bytes.data();
+            auto version = detail::load_le(h + 8, 4);
+            auto block = detail::load_le(h + 12, 4);
+            auto count = detail::load_le(h + 16, 8);
+            auto fence_count = detail::load_le(h + 24, 8);
+            auto keys_offset = detail::load_le(h + 32, 8);
+            auto fence_offset = detail::load_le(h + 40, 8);
+
+            if (version != format::version)
+                throw std::runtime_error("fquuid:uuid_set_file: unsupported format version");
+
+            auto records = (bytes.size() - format::header_size) / 16;
+            if (block == 0 || keys_offset != format::header_size
+                || count > records || fence_count != (count + block - 1) / block
+                || fence_count > records - count
+                || fence_offset != format::header_size + count * 16)
+                throw format_error();
+
+            keys_ = bytes.subspan(keys_offset, count * 16);
+            fence_ = bytes.subspan(fence_offset, fence_count * 16);
+            block_ = block;
+        }
+
+        size_t size() const noexcept { return keys_.size() / 16; }
+        bool empty() const noexcept { return keys_.empty(); }
+
+        uuid_view operator [](size_t index) const noexcept {
+            return uuid_view{std::span<const std::byte, 16>(record(keys_, index), 16)};
+        }
+
+        // every key as consecutive 16-byte big-endian records
+        std::span<const std::byte> records() const noexcept {
+            return keys_;
+        }
+
+        // index of the first key not less than key
+        size_t lower_bound(const uuid& key) const noexcept {
+            auto f = lower_bound(fence_, 0, fence_.size() / 16, key);
+            if (f == 0)
+                return 0;
+            return lower_bound(keys_, (f - 1) * block_, std::min(f * block_, size()), key);
+        }
+
+        bool contains(const uuid& key) const noexcept {
+            auto i = lower_bound(key);
+            return i < size() && (*this)[i] == key;
+        }
+
+        // keys with first <= key < last as consecutive 16-byte records, read with uuid_view::at or load_many
+        std::span<const std::byte> range(const uuid& first, const uuid& last) const noexcept {
+            if (!(first < last))
+                return {};
+            auto b = lower_bound(first);
+            auto e = lower_bound(last);
+            return keys_.subspan(b * 16, (e - b) * 16);
+        }
+    };
+
+    // Builds a sorted uuid set file from unsorted keys with an external merge sort.
+    // Keys are buffered up to run_keys, then radix sorted and spilled to a temporary run file
+    // next to the output. finish() merges the runs, drops duplicates and writes the file
+    // under a temporary name that is synced and renamed at the end, so readers never see
+    // a partial file, not even after a crash.
+    class uuid_set_file_writer
+    {
+        using format = detail::uuid_set_file_format;
+
+        std::filesystem::path path_;
+        size_t run_keys_;
+        uint32_t block_;
+        std::vector<uuid> buffer_;
+        std::vector<std::filesystem::path> runs_;
+
+        std::filesystem::path temp_path(const std::string& suffix) const {
+            auto p = path_;
+            p += suffix;
+            return p;
+        }
+
+        void sort_buffer() {
+            fquuid::sort(buffer_);
+            buffer_.erase(std::unique(buffer_.begin(), buffer_.end()), buffer_.end());
+        }
+
+        void spill() {
+            sort_buffer();
+            auto run = temp_path(".run" + std::to_string(runs_.size()));
+            auto f = detail::open_file(run, "wb");
+            runs_.push_back(run);
+
+            detail::uuid_record_writer w{f.get()};
+            for (auto& u : buffer_)
+                w.push(u);
+            w.flush();
+            detail::close_file(f);
+            buffer_.clear();
+        }
+
+        void remove_runs() noexcept {
+            std::error_code ec;
+            for (auto& run : runs_)
+                std::filesystem::remove(run, ec);
+            runs_.clear();
+        }
+
+        // feed(push) calls push(u) with every key in order, duplicates included
+        template <class Feed>
+        size_t write(Feed&& feed) {
+            auto temp = temp_path(".tmp");
+            try {
+                auto n = write(temp, feed);
+                std::filesystem::rename(temp, path_);
+                if (!detail::sync_directory(path_.parent_path()))
+                    throw std::runtime_error("fquuid:uuid_set_file_writer: can't sync directory");
+                return n;
+            }
+            catch (...) {
+                std::error_code ec;
+                std::filesystem::remove(temp, ec);
+                throw;
+            }
+        }
+
+        template <class Feed>
+        size_t write(const std::filesystem::path& temp, Feed& feed) {
+            auto f = detail::open_file(temp, "wb");
+
+            std::array<std::byte, format::header_size> header {};
+            detail::write_file(f.get(), header.data(), header.size());
+
+            std::vector<uuid> fence;
+            detail::uuid_record_writer keys{f.get()};
+            uint64_t count = 0;
+            uuid last;
+            feed([&](const uuid& u) {
+                if (count > 0 && u == last)
+                    return;
+                if (count % block_ == 0)
+                    fence.push_back(u);
+                keys.push(u);
+                last = u;
+                count++;
+            });
+            keys.flush();
+
+            detail::uuid_record_writer fences{f.get()};
+            for (auto& u : fence)
+                fences.push(u);
+            fences.flush();
+
+            std::copy(format::magic.begin(), format::magic.end(), reinterpret_cast<char*>(header.data()));
+            detail::store_le(header.data() + 8, format::version, 4);
+            detail::store_le(header.data() + 12, block_, 4);
+            detail::store_le(header.data() + 16, count, 8);
+            detail::store_le(header.data() + 24, fence.size(), 8);
+            detail::store_le(header.data() + 32, format::header_size, 8);
+            detail::store_le(header.data() + 40, format::header_size + count * 16, 8);
+
+            if (std::fseek(f.get(), 0, SEEK_SET) != 0)
+                throw std::runtime_error("fquuid:uuid_set_file_writer: seek error");
+            detail::write_file(f.get(), header.data(), header.size());
+            // the data must reach the disk before the rename does, or a crash can leave a torn file
+            detail::sync_file(f);
+            detail::close_file(f);
+            return count;
+        }
+
+    public:
+        // run_keys: keys held in memory (16 bytes each, plus the same again while sorting)
+        explicit uuid_set_file_writer(std::filesystem::path path, size_t run_keys = size_t{1} << 24,
+                                      uint32_t block = format::default_block)
+            : path_(std::move(path)), run_keys_(std::max<size_t>(run_keys, 1)), block_(block) {
+            if (block_ == 0)
+                throw std::invalid_argument("fquuid:uuid_set_file_writer: block must not be 0");
+        }
+
+        ~uuid_set_file_writer() {
+            remove_runs();
+        }
+
+        uuid_set_file_writer(const uuid_set_file_writer&) = delete;
+        uuid_set_file_writer& operator =(const uuid_set_file_writer&) = delete;
+
+        void add(const uuid& u) {
+            buffer_.push_back(u);
+            if (buffer_.size() >= run_keys_)
+                spill();
+        }
+
+        void add(std::span<const uuid> keys) {
+            for (auto& u : keys)
+                add(u);
+        }
+
+        // writes the file and returns the number of distinct keys
+        size_t finish() {
+            if (runs_.empty()) {
+                sort_buffer();
+                auto n = write([&](auto&& push) {
+                    for (auto& u : buffer_)
+                        push(u);
+                });
+                buffer_.clear();
+                return n;
+            }
+
+            if (!buffer_.empty())
+                spill();
+            buffer_.shrink_to_fit();
+
+            std::vector<detail::uuid_record_reader> readers;
+            for (auto& run : runs_)
+                readers.emplace_back(run);
+
+            auto n = write([&](auto&& push) {
+                using entry = std::pair<uuid, size_t>;
+                std::priority_queue<entry, std::vector<entry>, std::greater<>> heap;
+
+                uuid u;
+                for (size_t i = 0; i < readers.size(); i++) {
+                    if (readers[i].next(u))
+                        heap.emplace(u, i);
+                }
+                while (!heap.empty()) {
+                    auto [top, i] = heap.top();
+                    heap.pop();
+                    push(top);
+                    if (readers[i].next(u))
+                        heap.emplace(u, i);
+                }
+            });
+
+            readers.clear();
+            remove_runs();
+            return n;
+        }
+    };
+}
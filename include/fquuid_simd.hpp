@@ -0,0 +1,41 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+
+// SIMD feature detection.
+// Define FQUUID_NO_SIMD to force the portable scalar code paths.
+#if !defined(FQUUID_NO_SIMD)
+#   if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#       define FQUUID_SIMD_SSE2 1
+#       include <emmintrin.h>
+#   endif
+#   if defined(FQUUID_SIMD_SSE2) && (defined(__SSSE3__) || defined(__AVX__))
+#       define FQUUID_SIMD_SSSE3 1
+#       include <tmmintrin.h>
+#   endif
+#   if defined(FQUUID_SIMD_SSSE3) && defined(__AVX2__)
+#       define FQUUID_SIMD_AVX2 1
+#       include <immintrin.h>
+#   endif
+#endif
+
+namespace fquuid::detail
+{
+#ifdef FQUUID_SIMD_SSE2
+    // 0xff where lo <= c <= hi (signed compare, so c >= 0x80 never matches)
+    inline __m128i sse2_in_range(__m128i c, char lo, char hi) {
+        return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)),
+                             _mm_cmpgt_epi8(_mm_set1_epi8(hi + 1), c));
+    }
+#endif
+
+    inline void prefetch(const void* p) noexcept {
+#if defined(FQUUID_SIMD_SSE2)
+        _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+        __builtin_prefetch(p);
+#else
+        (void)p;
+#endif
+    }
+}
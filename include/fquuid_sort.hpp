@@ -0,0 +1,205 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "fquuid_uuid.hpp"
+
+namespace fquuid::detail
+{
+    // MSD radix sort over the 16 key bytes, most significant byte first.
+    // A byte that has the same value in every element of a range (v7 timestamp prefix,
+    // version, variant) costs one counting pass and no scatter.
+    // Buckets below small_size fit in cache and are finished with std::sort.
+    class uuid_radix_sort
+    {
+        using words = std::array<uint64_t, 2>; // upper, lower (uuid_u128 layout)
+        using histogram = std::array<size_t, 256>;
+
+        static_assert(sizeof(uuid) == sizeof(words));
+
+        // below this std::sort wins
+        static constexpr size_t small_size = 64;
+
+        // per thread, smaller inputs are sorted by one thread
+        static constexpr size_t min_chunk = 1 << 16;
+
+        // depth 0 is the first byte
+        static unsigned digit(const uuid& u, int depth) noexcept {
+            auto w = std::bit_cast<words>(u);
+            return static_cast<unsigned>((depth < 8 ? w[0] >> (8 * (7 - depth)) : w[1] >> (8 * (15 - depth))) & 0xff);
+        }
+
+        static void count(std::span<const uuid> data, int depth, histogram& h) noexcept {
+            h.fill(0);
+            for (auto& u : data)
+                h[digit(u, depth)]++;
+        }
+
+        static bool is_uniform(const histogram& h, size_t n) noexcept {
+            return std::find(h.begin(), h.end(), n) != h.end();
+        }
+
+        static void scatter(std::span<const uuid> src, uuid* dst, int depth, histogram& offset) noexcept {
+            for (auto& u : src)
+                dst[offset[digit(u, depth)]++] = u;
+        }
+
+        // Sorts the n elements at a, using b as scratch.
+        // The result ends in b when into_b, otherwise in a; the buffers swap roles at every level.
+        static void sort(uuid* a, uuid* b, size_t n, int depth, bool into_b) {
+            if (n < small_size) {
+                std::sort(a, a + n);
+                if (into_b)
+                    std::copy(a, a + n, b);
+                return;
+            }
+
+            histogram h;
+            for (;; depth++) {
+                if (depth == 16) {
+                    // all equal
+                    if (into_b)
+                        std::copy(a, a + n, b);
+                    return;
+                }
+                count(std::span(a, n), depth, h);
+                if (!is_uniform(h, n))
+                    break;
+            }
+
+            histogram offset;
+            size_t sum = 0;
+            for (size_t d = 0; d < 256; d++) {
+                offset[d] = sum;
+                sum += h[d];
+            }
+            scatter(std::span(a, n), b, depth, offset);
+
+            size_t begin = 0;
+            for (size_t d = 0; d < 256; d++) {
+                if (h[d] > 1)
+                    sort(b + begin, a + begin, h[d], depth + 1, !into_b);
+                else if (h[d] == 1 && !into_b)
+                    a[begin] = b[begin];
+                begin += h[d];
+            }
+        }
+
+    public:
+        static void sort(std::span<uuid> data, std::span<uuid> scratch) {
+            if (scratch.size() < data.size())
+                throw std::invalid_argument("fquuid:sort: scratch span size insufficient");
+            sort(data.data(), scratch.data(), data.size(), 0, false);
+        }
+
+        // The threads count and scatter their own chunks of the first non-uniform byte
+        // with private offsets, then take the resulting buckets one by one.
+        static void parallel_sort(std::span<uuid> data, std::span<uuid> scratch, unsigned threads) {
+            auto n = data.size();
+            if (scratch.size() < n)
+                throw std::invalid_argument("fquuid:sort: scratch span size insufficient");
+
+            if (threads == 0)
+                threads = std::max(1u, std::thread::hardware_concurrency());
+            threads = static_cast<unsigned>(std::min<size_t>(threads, n / min_chunk));
+            if (threads <= 1) {
+                sort(data, scratch);
+                return;
+            }
+
+            std::vector<histogram> local(threads);
+            histogram total;
+            histogram start;
+            int depth = 0;
+            bool uniform = true;
+            std::atomic<size_t> next_bucket = 0;
+
+            auto chunk = [&](unsigned t) {
+                auto b = n * t / threads;
+                auto e = n * (t + 1) / threads;
+                return std::span(data.data() + b, e - b);
+            };
+
+            // after counting one byte: move on when uniform, otherwise bucket-major, thread-minor offsets
+            auto merge = [&]() noexcept {
+                total.fill(0);
+                for (auto& l : local) {
+                    for (size_t d = 0; d < 256; d++)
+                        total[d] += l[d];
+                }
+                uniform = is_uniform(total, n);
+                if (uniform) {
+                    depth++;
+                    return;
+                }
+
+                size_t sum = 0;
+                for (size_t d = 0; d < 256; d++) {
+                    start[d] = sum;
+                    for (auto& l : local) {
+                        auto c = l[d];
+                        l[d] = sum;
+                        sum += c;
+                    }
+                }
+            };
+
+            std::barrier counted(threads, merge);
+            std::barrier scattered(threads);
+
+            auto work = [&](unsigned t) {
+                do {
+                    if (depth == 16)
+                        return; // all equal
+                    count(chunk(t), depth, local[t]);
+                    counted.arrive_and_wait();
+                } while (uniform);
+
+                scatter(chunk(t), scratch.data(), depth, local[t]);
+                scattered.arrive_and_wait();
+
+                for (size_t d; (d = next_bucket++) < 256;)
+                    sort(scratch.data() + start[d], data.data() + start[d], total[d], depth + 1, true);
+            };
+
+            std::vector<std::jthread> workers;
+            for (unsigned t = 1; t < threads; t++)
+                workers.emplace_back(work, t);
+            work(0);
+        }
+    };
+}
+
+namespace fquuid
+{
+    // Sorts by uuid order (the 16 big-endian bytes) with an MSD radix sort.
+    // scratch needs data.size() elements.
+    inline void sort(std::span<uuid> data, std::span<uuid> scratch) {
+        detail::uuid_radix_sort::sort(data, scratch);
+    }
+
+    inline void sort(std::span<uuid> data) {
+        std::vector<uuid> scratch(data.size());
+        detail::uuid_radix_sort::sort(data, scratch);
+    }
+
+    // threads = 0 uses std::thread::hardware_concurrency()
+    inline void parallel_sort(std::span<uuid> data, std::span<uuid> scratch, unsigned threads = 0) {
+        detail::uuid_radix_sort::parallel_sort(data, scratch, threads);
+    }
+
+    inline void parallel_sort(std::span<uuid> data, unsigned threads = 0) {
+        std::vector<uuid> scratch(data.size());
+        detail::uuid_radix_sort::parallel_sort(data, scratch, threads);
+    }
+}
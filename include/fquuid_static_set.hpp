@@ -0,0 +1,167 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_simd.hpp"
+#include "fquuid_sort.hpp"
+
+namespace fquuid
+{
+    // Immutable set for tables built once and queried many times.
+    //
+    // Keys are stored in Eytzinger (BFS) order: node k has the children 2k and 2k + 1, so a search
+    // walks one path from the front of the array and the top levels stay in cache.
+    // Upper words live in their own 64-byte aligned array, 8 to a cache line: the line at 8k holds
+    // the descendants of k three levels down and is prefetched while the search is still at k.
+    // Lower words are read only when upper words tie.
+    class uuid_static_set
+    {
+        using words = std::array<uint64_t, 2>; // upper, lower (uuid_u128 layout)
+
+        struct alignas(64) line
+        {
+            uint64_t w[8];
+        };
+
+        static constexpr size_t batch_size = 8;
+
+        std::vector<line> upper_; // index 0 unused
+        std::vector<uint64_t> lower_;
+        size_t size_ = 0;
+
+        const uint64_t* upper() const noexcept {
+            return upper_.data()->w;
+        }
+
+        // in-order walk of the implicit tree assigns the sorted keys
+        void build(std::span<const uuid> sorted, size_t& i, size_t k) {
+            if (k > size_)
+                return;
+            build(sorted, i, 2 * k);
+            auto w = std::bit_cast<words>(sorted[i++]);
+            upper_[k / 8].w[k % 8] = w[0];
+            lower_[k] = w[1];
+            build(sorted, i, 2 * k + 1);
+        }
+
+        bool less(const uint64_t* up, size_t k, uint64_t hi, uint64_t lo) const noexcept {
+            auto u = up[k];
+            return u != hi ? u < hi : lower_[k] < lo;
+        }
+
+        // the search ran off the tree below the lower bound: drop the trailing right turns and one left turn
+        static size_t lower_bound_node(size_t k) noexcept {
+            return k >> (std::countr_one(k) + 1);
+        }
+
+        bool is_key(const uint64_t* up, size_t k, uint64_t hi, uint64_t lo) const noexcept {
+            return k != 0 && up[k] == hi && lower_[k] == lo;
+        }
+
+        void assign_sorted(std::span<const uuid> sorted) {
+            size_ = sorted.size();
+            upper_.assign(size_ / 8 + 1, line{});
+            lower_.assign(size_ + 1, 0);
+            size_t i = 0;
+            build(sorted, i, 1);
+        }
+
+    public:
+        using value_type = uuid;
+        using size_type = size_t;
+
+        uuid_static_set() : upper_(1), lower_(1) {}
+
+        // keys need not be sorted or distinct
+        explicit uuid_static_set(std::span<const uuid> keys) {
+            std::vector<uuid> sorted(keys.begin(), keys.end());
+            fquuid::sort(sorted);
+            sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+            assign_sorted(sorted);
+        }
+
+        uuid_static_set(std::initializer_list<uuid> keys)
+            : uuid_static_set(std::span<const uuid>(keys.begin(), keys.size())) {}
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+
+        bool contains(const uuid& key) const noexcept {
+            auto [hi, lo] = std::bit_cast<words>(key);
+            auto up = upper();
+
+            size_t k = 1;
+            while (k <= size_) {
+                // may point past the end: prefetch never faults
+                detail::prefetch(up + 8 * k);
+                k = 2 * k + less(up, k, hi, lo);
+            }
+            return is_key(up, lower_bound_node(k), hi, lo);
+        }
+
+        // Interleaves batch_size searches level by level so their cache misses overlap.
+        // found[i] = contains(keys[i]), returns the number of keys found
+        size_t contains_many(std::span<const uuid> keys, std::span<bool> found) const {
+            if (found.size() < keys.size())
+                throw std::invalid_argument("fquuid:contains_many: output span size insufficient");
+
+            auto up = upper();
+            auto depth = std::bit_width(size_);
+            size_t n = 0;
+
+            for (size_t b = 0; b < keys.size(); b += batch_size) {
+                auto m = std::min(batch_size, keys.size() - b);
+                std::array<words, batch_size> w;
+                std::array<size_t, batch_size> k;
+                for (size_t j = 0; j < m; j++) {
+                    w[j] = std::bit_cast<words>(keys[b + j]);
+                    k[j] = 1;
+                }
+
+                for (size_t d = 0; d < depth; d++) {
+                    for (size_t j = 0; j < m; j++) {
+                        if (k[j] <= size_) {
+                            detail::prefetch(up + 8 * k[j]);
+                            k[j] = 2 * k[j] + less(up, k[j], w[j][0], w[j][1]);
+                        }
+                    }
+                }
+
+                for (size_t j = 0; j < m; j++) {
+                    bool hit = is_key(up, lower_bound_node(k[j]), w[j][0], w[j][1]);
+                    found[b + j] = hit;
+                    n += hit;
+                }
+            }
+            return n;
+        }
+
+        // every key in ascending order
+        std::vector<uuid> to_vector() const {
+            std::vector<uuid> v;
+            v.reserve(size_);
+            auto up = upper();
+            // in-order successor walk: leftmost node, then up until coming from the left
+            for (size_t k = size_ == 0 ? 0 : size_t{1} << (std::bit_width(size_) - 1); k != 0;) {
+                v.push_back(std::bit_cast<uuid>(words{up[k], lower_[k]}));
+                if (2 * k + 1 <= size_) {
+                    k = 2 * k + 1;
+                    while (2 * k <= size_)
+                        k *= 2;
+                }
+                else
+                    k = lower_bound_node(k);
+            }
+            return v;
+        }
+    };
+}
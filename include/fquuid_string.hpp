@@ -13,9 +13,20 @@
 
 namespace fquuid::detail
 {
-    template <class CharT>
+    template <class CharT, format::hex_flags Flags = format::hex_flags::none>
     class uuid_basic_string
     {
+        static constexpr bool upper_case = format::has_flag(Flags, format::hex_flags::upper);
+        static constexpr bool dashes = !format::has_flag(Flags, format::hex_flags::no_dashes);
+        static constexpr bool braces = format::has_flag(Flags, format::hex_flags::braces);
+        static constexpr bool urn = format::has_flag(Flags, format::hex_flags::urn);
+
+        static_assert(!(braces && urn), "fquuid: braces and urn formats cannot be combined");
+
+    public:
+        static constexpr size_t length = (dashes ? 36 : 32) + (braces ? 2 : 0) + (urn ? 9 : 0);
+
+    private:
         static constexpr auto hex_to_u4_table = [] {
             std::array<int8_t, 256> a;
             for (size_t i = 0; i < a.size(); i++) {
@@ -42,57 +53,38 @@ namespace fquuid::detail
             return hex_to_u4_table[static_cast<size_t>(c) & 0xff];
         }
 
+        // load_uNN_hex: ok = 0 - 2^NN-1, error = bits above NN are set
         static constexpr uint64_t load_u16_hex(std::span<const CharT, 4> s) {
-            auto u16e = (hex_to_u4(fixed_at<0>(s)) << 12 |
-                         hex_to_u4(fixed_at<1>(s)) << 8 |
-                         hex_to_u4(fixed_at<2>(s)) << 4 |
-                         hex_to_u4(fixed_at<3>(s)));
-
-            if (u16e >> 16)
-                throw std::invalid_argument("fquuid:parse: invalid hexadecimal character");
-            else
-                return u16e;
+            return (hex_to_u4(fixed_at<0>(s)) << 12 |
+                    hex_to_u4(fixed_at<1>(s)) << 8 |
+                    hex_to_u4(fixed_at<2>(s)) << 4 |
+                    hex_to_u4(fixed_at<3>(s)));
         }
 
         static constexpr uint64_t load_u32_hex(std::span<const CharT, 8> s) {
-            auto u32e = (hex_to_u4(fixed_at<0>(s)) << 28 |
-                         hex_to_u4(fixed_at<1>(s)) << 24 |
-                         hex_to_u4(fixed_at<2>(s)) << 20 |
-                         hex_to_u4(fixed_at<3>(s)) << 16 |
-                         hex_to_u4(fixed_at<4>(s)) << 12 |
-                         hex_to_u4(fixed_at<5>(s)) << 8 |
-                         hex_to_u4(fixed_at<6>(s)) << 4 |
-                         hex_to_u4(fixed_at<7>(s)));
-
-            if (u32e >> 32)
-                throw std::invalid_argument("fquuid:parse: invalid hexadecimal character");
-            else
-                return u32e;
+            return (hex_to_u4(fixed_at<0>(s)) << 28 |
+                    hex_to_u4(fixed_at<1>(s)) << 24 |
+                    hex_to_u4(fixed_at<2>(s)) << 20 |
+                    hex_to_u4(fixed_at<3>(s)) << 16 |
+                    hex_to_u4(fixed_at<4>(s)) << 12 |
+                    hex_to_u4(fixed_at<5>(s)) << 8 |
+                    hex_to_u4(fixed_at<6>(s)) << 4 |
+                    hex_to_u4(fixed_at<7>(s)));
         }
 
         static constexpr uint64_t load_u48_hex(std::span<const CharT, 12> s) {
-            auto u48e = (hex_to_u4(fixed_at<0>(s)) << 44 |
-                         hex_to_u4(fixed_at<1>(s)) << 40 |
-                         hex_to_u4(fixed_at<2>(s)) << 36 |
-                         hex_to_u4(fixed_at<3>(s)) << 32 |
-                         hex_to_u4(fixed_at<4>(s)) << 28 |
-                         hex_to_u4(fixed_at<5>(s)) << 24 |
-                         hex_to_u4(fixed_at<6>(s)) << 20 |
-                         hex_to_u4(fixed_at<7>(s)) << 16 |
-                         hex_to_u4(fixed_at<8>(s)) << 12 |
-                         hex_to_u4(fixed_at<9>(s)) << 8 |
-                         hex_to_u4(fixed_at<10>(s)) << 4 |
-                         hex_to_u4(fixed_at<11>(s)));
-
-            if (u48e >> 48)
-                throw std::invalid_argument("fquuid:parse: invalid hexadecimal character");
-            else
-                return u48e;
-        }
-
-        static constexpr uint64_t load_u64_hex(std::span<const CharT, 16> s) {
-            return (load_u32_hex(fixed_subspan<0, 8>(s)) << 32 |
-                    load_u32_hex(fixed_subspan<8, 8>(s)));
+            return (hex_to_u4(fixed_at<0>(s)) << 44 |
+                    hex_to_u4(fixed_at<1>(s)) << 40 |
+                    hex_to_u4(fixed_at<2>(s)) << 36 |
+                    hex_to_u4(fixed_at<3>(s)) << 32 |
+                    hex_to_u4(fixed_at<4>(s)) << 28 |
+                    hex_to_u4(fixed_at<5>(s)) << 24 |
+                    hex_to_u4(fixed_at<6>(s)) << 20 |
+                    hex_to_u4(fixed_at<7>(s)) << 16 |
+                    hex_to_u4(fixed_at<8>(s)) << 12 |
+                    hex_to_u4(fixed_at<9>(s)) << 8 |
+                    hex_to_u4(fixed_at<10>(s)) << 4 |
+                    hex_to_u4(fixed_at<11>(s)));
         }
 
         static constexpr auto u4_to_hex_table = [] {
@@ -100,7 +92,7 @@ namespace fquuid::detail
             for (int i = 0; i < 10; i++)
                 a[i] = 0x30 + i; // [0-9]
             for (int i = 0; i < 6; i++)
-                a[10 + i] = 0x61 + i; // [a-f]
+                a[10 + i] = (upper_case ? 0x41 : 0x61) + i; // [A-F] or [a-f]
             return a;
         }();
 
@@ -134,6 +126,21 @@ namespace fquuid::detail
             return s;
         }
 
+        static constexpr bool has_urn_prefix(std::span<const CharT> s) {
+            constexpr std::string_view prefix = "urn:uuid:";
+
+            if (s.size() < prefix.size())
+                return false;
+            for (size_t i = 0; i < prefix.size(); i++) {
+                auto c = s[i];
+                if (c >= 'A' && c <= 'Z')
+                    c = c - 'A' + 'a';
+                if (c != static_cast<CharT>(prefix[i]))
+                    return false;
+            }
+            return true;
+        }
+
         static constexpr std::span<const CharT> trim_braces(std::span<const CharT> s) {
             if (s.size() >= 2 && s.front() == '{' && s.back() == '}')
                 return s.subspan(1, s.size() - 2);
@@ -148,21 +155,57 @@ namespace fquuid::detail
         }
 
         // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+        static constexpr bool load_standard_format(uuid_u128& u, std::span<const CharT, 36> s) {
+            auto x0 = load_u32_hex(fixed_subspan<0, 8>(s));
+            auto x1 = load_u16_hex(fixed_subspan<9, 4>(s));
+            auto x2 = load_u16_hex(fixed_subspan<14, 4>(s));
+            auto x3 = load_u16_hex(fixed_subspan<19, 4>(s));
+            auto x4 = load_u48_hex(fixed_subspan<24, 12>(s));
+
+            if ((x0 >> 32 | x1 >> 16 | x2 >> 16 | x3 >> 16 | x4 >> 48) != 0)
+                return false;
+
+            u.upper(x0 << 32 | x1 << 16 | x2);
+            u.lower(x3 << 48 | x4);
+            return true;
+        }
+
+        // xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
+        static constexpr bool load_hex_format(uuid_u128& u, std::span<const CharT, 32> s) {
+            auto x0 = load_u32_hex(fixed_subspan<0, 8>(s));
+            auto x1 = load_u32_hex(fixed_subspan<8, 8>(s));
+            auto x2 = load_u32_hex(fixed_subspan<16, 8>(s));
+            auto x3 = load_u32_hex(fixed_subspan<24, 8>(s));
+
+            if ((x0 | x1 | x2 | x3) >> 32)
+                return false;
+
+            u.upper(x0 << 32 | x1);
+            u.lower(x2 << 32 | x3);
+            return true;
+        }
+
         static constexpr void parse_standard_format(uuid_u128& u, std::span<const CharT, 36> s) {
             if (!has_dashes(s))
                 throw std::invalid_argument("fquuid:parse: invalid UUID format");
+            if (!load_standard_format(u, s))
+                throw std::invalid_argument("fquuid:parse: invalid hexadecimal character");
+        }
 
-            u.upper(load_u32_hex(fixed_subspan<0, 8>(s)) << 32 |
-                    load_u16_hex(fixed_subspan<9, 4>(s)) << 16 |
-                    load_u16_hex(fixed_subspan<14, 4>(s)));
-            u.lower(load_u16_hex(fixed_subspan<19, 4>(s)) << 48 |
-                    load_u48_hex(fixed_subspan<24, 12>(s)));
+        static constexpr void parse_hex_format(uuid_u128& u, std::span<const CharT, 32> s) {
+            if (!load_hex_format(u, s))
+                throw std::invalid_argument("fquuid:parse: invalid hexadecimal character");
+        }
+
+        static constexpr void store_u64_hex(uint64_t x, std::span<CharT, 16> s) {
+            store_u32_hex(x >> 32, fixed_subspan<0, 8>(s));
+            store_u32_hex(x, fixed_subspan<8, 8>(s));
         }
 
         // xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
-        static constexpr void parse_hex_format(uuid_u128& u, std::span<const CharT, 32> s) {
-            u.upper(load_u64_hex(fixed_subspan<0, 16>(s)));
-            u.lower(load_u64_hex(fixed_subspan<16, 16>(s)));
+        static constexpr void write_hex_format(const uuid_u128& u, std::span<CharT, 32> s) {
+            store_u64_hex(u.upper(), fixed_subspan<0, 16>(s));
+            store_u64_hex(u.lower(), fixed_subspan<16, 16>(s));
         }
 
         // xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
@@ -179,9 +222,31 @@ namespace fquuid::detail
             fixed_at<23>(s) = '-';
         }
 
+        static constexpr void write_format(const uuid_u128& u, std::span<CharT, length> s) {
+            if constexpr (urn) {
+                constexpr std::string_view prefix = "urn:uuid:";
+                for (size_t i = 0; i < prefix.size(); i++)
+                    s[i] = prefix[i];
+            }
+            if constexpr (braces) {
+                fixed_front(s) = '{';
+                fixed_back(s) = '}';
+            }
+
+            constexpr size_t offset = (urn ? 9 : 0) + (braces ? 1 : 0);
+            if constexpr (dashes)
+                write_standard_format(u, fixed_subspan<offset, 36>(s));
+            else
+                write_hex_format(u, fixed_subspan<offset, 32>(s));
+        }
+
     public:
         static constexpr void parse(uuid_u128& u, std::span<const CharT> s) {
-            auto trimmed = trim_braces(trim_null_terminator(s));
+            auto trimmed = trim_null_terminator(s);
+            if (has_urn_prefix(trimmed))
+                trimmed = trimmed.subspan(9);
+            else
+                trimmed = trim_braces(trimmed);
 
             if (auto fixed = try_fixed_equal<36>(trimmed))
                 parse_standard_format(u, *fixed);
@@ -191,6 +256,15 @@ namespace fquuid::detail
                 throw std::invalid_argument("fquuid:parse: invalid UUID string length");
         }
 
+        // Non-throwing parse of the bare 36 and 32 character formats
+        static constexpr bool try_parse_standard(uuid_u128& u, std::span<const CharT, 36> s) noexcept {
+            return has_dashes(s) && load_standard_format(u, s);
+        }
+
+        static constexpr bool try_parse_hex(uuid_u128& u, std::span<const CharT, 32> s) noexcept {
+            return load_hex_format(u, s);
+        }
+
         static constexpr void parse(uuid_u128& u, const CharT* s) {
             if (s == nullptr)
                 throw std::invalid_argument("fquuid:parse: argument is nullptr");
@@ -200,16 +274,16 @@ namespace fquuid::detail
 
         static constexpr size_t write(const uuid_u128& u, std::span<CharT> s, string_terminator term) {
             if (term == string_terminator::null) {
-                if (auto fixed = try_fixed<37>(s)) {
-                    write_standard_format(u, fixed_first<36>(*fixed));
+                if (auto fixed = try_fixed<length + 1>(s)) {
+                    write_format(u, fixed_first<length>(*fixed));
                     fixed_back(*fixed) = 0;
                     return fixed->size();
                 } else {
                     throw std::invalid_argument("fquuid:write: output span size insufficient");
                 }
             } else {
-                if (auto fixed = try_fixed<36>(s)) {
-                    write_standard_format(u, *fixed);
+                if (auto fixed = try_fixed<length>(s)) {
+                    write_format(u, *fixed);
                     return fixed->size();
                 } else {
                     throw std::invalid_argument("fquuid:write: output span size insufficient");
@@ -224,3 +298,26 @@ namespace fquuid::detail
     using uuid_u16string = uuid_basic_string<char16_t>;
     using uuid_u32string = uuid_basic_string<char32_t>;
 }
+
+namespace fquuid::format
+{
+    template <hex_flags Flags>
+    struct hex
+    {
+        static constexpr hex_flags flags = Flags;
+        static constexpr size_t length = detail::uuid_basic_string<char, Flags>::length;
+
+        template <class CharT>
+        using codec = detail::uuid_basic_string<CharT, Flags>;
+    };
+
+    using standard = hex<hex_flags::none>;
+    using upper = hex<hex_flags::upper>;
+    using hex32 = hex<hex_flags::no_dashes>;
+    using braced = hex<hex_flags::braces>;
+    using urn = hex<hex_flags::urn>;
+
+    // e.g. combine<upper, braced> = {XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX}
+    template <class... Formats>
+    using combine = hex<(Formats::flags | ... | hex_flags::none)>;
+}
@@ -1,20 +1,114 @@
 // Copyright 2024 granz.fisherman@gmail.com
 // https://opensource.org/license/mit
 #pragma once
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
+#include "fquuid_simd.hpp"
+
+// 128-bit integer comparison.
+// Define FQUUID_NO_INT128 to compare the two 64-bit words separately.
+#if !defined(FQUUID_NO_INT128) && defined(__SIZEOF_INT128__)
+#   define FQUUID_HAS_INT128 1
+#endif
 
 namespace fquuid
 {
     namespace detail
     {
-        struct uuid_u128
+#ifdef FQUUID_HAS_INT128
+        __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+        // 64 x 64 -> 128-bit product as { low, high }
+        constexpr std::array<uint64_t, 2> mul_wide(uint64_t a, uint64_t b) noexcept {
+#ifdef FQUUID_HAS_INT128
+            auto r = static_cast<uint128_t>(a) * b;
+            return { static_cast<uint64_t>(r), static_cast<uint64_t>(r >> 64) };
+#else
+            uint64_t a_lo = a & 0xffff'ffff, a_hi = a >> 32;
+            uint64_t b_lo = b & 0xffff'ffff, b_hi = b >> 32;
+            uint64_t ll = a_lo * b_lo, lh = a_lo * b_hi, hl = a_hi * b_lo, hh = a_hi * b_hi;
+            uint64_t mid = (ll >> 32) + (lh & 0xffff'ffff) + (hl & 0xffff'ffff);
+            uint64_t lo = (ll & 0xffff'ffff) | (mid << 32);
+            uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+            return { lo, hi };
+#endif
+        }
+
+        // high and low halves of the product folded by xor
+        constexpr uint64_t mul_fold(uint64_t a, uint64_t b) noexcept {
+            auto [lo, hi] = mul_wide(a, b);
+            return lo ^ hi;
+        }
+
+        // high half of the product, maps a 64-bit hash onto [0, b)
+        constexpr uint64_t mul_hi(uint64_t a, uint64_t b) noexcept {
+            return mul_wide(a, b)[1];
+        }
+
+        // little-endian integers in file headers and serialized structures
+        constexpr void store_le(std::byte* p, uint64_t v, int bytes) noexcept {
+            for (int i = 0; i < bytes; i++)
+                p[i] = static_cast<std::byte>(v >> (8 * i));
+        }
+
+        constexpr uint64_t load_le(const std::byte* p, int bytes) noexcept {
+            uint64_t v = 0;
+            for (int i = 0; i < bytes; i++)
+                v |= std::to_integer<uint64_t>(p[i]) << (8 * i);
+            return v;
+        }
+
+        // v_[0] holds the upper 64 bits, so the byte layout is unchanged
+        // whether or not the 128-bit integer path is enabled.
+        struct alignas(16) uuid_u128
         {
             using value_type = uint64_t;
 
             value_type v_[2];
 
-            constexpr auto operator <=>(const uuid_u128&) const = default;
+#ifdef FQUUID_HAS_INT128
+            constexpr uint128_t to_u128() const noexcept {
+                return (static_cast<uint128_t>(v_[0]) << 64) | v_[1];
+            }
+
+            // two borrow chains and no branch on equality
+            constexpr std::strong_ordering operator <=>(const uuid_u128& r) const noexcept {
+                auto a = to_u128();
+                auto b = r.to_u128();
+                return a < b ? std::strong_ordering::less
+                             : b < a ? std::strong_ordering::greater : std::strong_ordering::equal;
+            }
+
+            constexpr bool operator <(const uuid_u128& r) const noexcept {
+                return to_u128() < r.to_u128();
+            }
+#else
+            constexpr std::strong_ordering operator <=>(const uuid_u128& r) const noexcept {
+                auto c = v_[0] <=> r.v_[0];
+                return c != 0 ? c : v_[1] <=> r.v_[1];
+            }
+
+            constexpr bool operator <(const uuid_u128& r) const noexcept {
+                return v_[0] < r.v_[0] || (v_[0] == r.v_[0] && v_[1] < r.v_[1]);
+            }
+#endif
+
+            constexpr bool operator ==(const uuid_u128& r) const noexcept {
+#ifdef FQUUID_SIMD_SSE2
+                if (!std::is_constant_evaluated()) {
+                    auto a = _mm_load_si128(reinterpret_cast<const __m128i*>(v_));
+                    auto b = _mm_load_si128(reinterpret_cast<const __m128i*>(r.v_));
+                    return _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) == 0xffff;
+                }
+#endif
+                return ((v_[0] ^ r.v_[0]) | (v_[1] ^ r.v_[1])) == 0;
+            }
 
             constexpr value_type upper() const noexcept { return v_[0]; }
             constexpr value_type lower() const noexcept { return v_[1]; }
@@ -26,6 +120,17 @@ namespace fquuid
                 return upper() == 0 && lower() == 0;
             }
 
+            // Multiply-folds (as in wyhash), every input bit reaches every output bit.
+            // Each multiply has a constant operand: a key-derived one could be zero and
+            // would make the product ignore the other half of the key. The halves are
+            // folded independently, so the latency is still two multiplies, and both take
+            // the seed, so no collision within one half holds across seeds.
+            constexpr uint64_t hash(uint64_t seed = 0) const noexcept {
+                auto h = mul_fold(upper() ^ seed ^ 0xa076'1d64'78bd'642f, 0xe703'7ed1'a0b4'28db);
+                auto l = mul_fold(lower() ^ std::rotl(seed, 32) ^ 0x4b33'a62e'd433'd4a3, 0x0589'965c'c753'74cc);
+                return mul_fold(h ^ l ^ seed, 0x8ebc'6af0'9c88'c6e3);
+            }
+
             constexpr uint8_t version() const noexcept {
                 return (upper() >> 12) & 0x0f;
             }
@@ -61,5 +166,52 @@ namespace fquuid
         requires !std::is_same_v<ByteT, bool>;
     };
 
+    template <class Format>
+    concept UuidFormat = requires {
+        { Format::length } -> std::convertible_to<size_t>;
+        typename Format::template codec<char>;
+    };
+
+    template <class Layout>
+    concept UuidLayout = requires {
+        { Layout::mixed_endian } -> std::convertible_to<bool>;
+    };
+
     enum class string_terminator { none, null };
+
+    namespace layout
+    {
+        // RFC 9562 network byte order
+        struct big_endian
+        {
+            static constexpr bool mixed_endian = false;
+        };
+
+        // Microsoft GUID / SQL Server uniqueidentifier:
+        // time_low, time_mid and time_hi_and_version little-endian, the rest as is
+        struct guid
+        {
+            static constexpr bool mixed_endian = true;
+        };
+    }
+
+    namespace format
+    {
+        enum class hex_flags : unsigned
+        {
+            none = 0,
+            upper = 1 << 0,     // [A-F] instead of [a-f]
+            no_dashes = 1 << 1, // 32 hexadecimal digits
+            braces = 1 << 2,    // {...}
+            urn = 1 << 3,       // urn:uuid:...
+        };
+
+        constexpr hex_flags operator |(hex_flags a, hex_flags b) noexcept {
+            return static_cast<hex_flags>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+        }
+
+        constexpr bool has_flag(hex_flags flags, hex_flags f) noexcept {
+            return (static_cast<unsigned>(flags) & static_cast<unsigned>(f)) != 0;
+        }
+    }
 }
@@ -5,6 +5,7 @@
 #include <compare>
 #include <cstdint>
 #include <functional>
+#include <istream>
 #include <ostream>
 #include <span>
 #include <stdexcept>
@@ -12,6 +13,12 @@
 #include "fquuid_types.hpp"
 #include "fquuid_string.hpp"
 #include "fquuid_binary.hpp"
+#include "fquuid_encoding.hpp"
+#include "fquuid_fixed_string.hpp"
+
+#if __has_include(<format>)
+#include <format>
+#endif
 
 namespace fquuid
 {
@@ -19,6 +26,13 @@ namespace fquuid
     {
         detail::uuid_u128 u_;
 
+        template <class Format, class CharT, class Source>
+        static constexpr uuid parse_format(Source s) {
+            detail::uuid_u128 u {};
+            Format::template codec<CharT>::parse(u, s);
+            return uuid{u};
+        }
+
     public:
         constexpr uuid() noexcept : u_{} {}
 
@@ -72,8 +86,77 @@ namespace fquuid
             detail::uuid_binary_byte::load_from_bytes(u_, bytes);
         }
 
+        template <UuidLayout Layout>
+        static constexpr uuid from_bytes(std::span<const uint8_t> bytes) {
+            detail::uuid_u128 u {};
+            detail::uuid_basic_binary<uint8_t, Layout>::load_from_bytes(u, bytes);
+            return uuid{u};
+        }
+
+        template <UuidLayout Layout>
+        static constexpr uuid from_bytes(std::span<const std::byte> bytes) {
+            detail::uuid_u128 u {};
+            detail::uuid_basic_binary<std::byte, Layout>::load_from_bytes(u, bytes);
+            return uuid{u};
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(std::span<const char> s) {
+            return parse_format<Format, char>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(std::span<const wchar_t> s) {
+            return parse_format<Format, wchar_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(std::span<const char8_t> s) {
+            return parse_format<Format, char8_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(std::span<const char16_t> s) {
+            return parse_format<Format, char16_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(std::span<const char32_t> s) {
+            return parse_format<Format, char32_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(const char* s) {
+            return parse_format<Format, char>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(const wchar_t* s) {
+            return parse_format<Format, wchar_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(const char8_t* s) {
+            return parse_format<Format, char8_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(const char16_t* s) {
+            return parse_format<Format, char16_t>(s);
+        }
+
+        template <UuidFormat Format>
+        static constexpr uuid parse(const char32_t* s) {
+            return parse_format<Format, char32_t>(s);
+        }
+
         constexpr auto operator <=>(const uuid&) const = default;
 
+        // direct overload so sorting does not go through <=>
+        constexpr bool operator <(const uuid& r) const noexcept {
+            return u_ < r.u_;
+        }
+
         constexpr bool is_nil() const noexcept {
             return u_.is_nil();
         }
@@ -82,6 +165,11 @@ namespace fquuid
             return u_.version();
         }
 
+        // v7 timestamp, meaningful only when get_version() == 7
+        constexpr int64_t get_unix_ts_ms() const noexcept {
+            return u_.unix_ts_ms();
+        }
+
         constexpr size_t write_string(std::span<char> s, string_terminator term = string_terminator::null) const {
             return detail::uuid_string::write(u_, s, term);
         }
@@ -102,7 +190,33 @@ namespace fquuid
             return detail::uuid_u32string::write(u_, s, term);
         }
 
+        template <UuidFormat Format>
+        constexpr size_t write_string(std::span<char> s, string_terminator term = string_terminator::null) const {
+            return Format::template codec<char>::write(u_, s, term);
+        }
+
+        template <UuidFormat Format>
+        constexpr size_t write_string(std::span<wchar_t> s, string_terminator term = string_terminator::null) const {
+            return Format::template codec<wchar_t>::write(u_, s, term);
+        }
+
+        template <UuidFormat Format>
+        constexpr size_t write_string(std::span<char8_t> s, string_terminator term = string_terminator::null) const {
+            return Format::template codec<char8_t>::write(u_, s, term);
+        }
+
+        template <UuidFormat Format>
+        constexpr size_t write_string(std::span<char16_t> s, string_terminator term = string_terminator::null) const {
+            return Format::template codec<char16_t>::write(u_, s, term);
+        }
+
+        template <UuidFormat Format>
+        constexpr size_t write_string(std::span<char32_t> s, string_terminator term = string_terminator::null) const {
+            return Format::template codec<char32_t>::write(u_, s, term);
+        }
+
         template <class String = std::string>
+            requires (!UuidFormat<String>)
         String to_string() const {
             using CharT = typename String::value_type;
 
@@ -111,6 +225,22 @@ namespace fquuid
             return s;
         }
 
+        template <UuidFormat Format, class String = std::string>
+        String to_string() const {
+            using CharT = typename String::value_type;
+
+            String s(Format::length, 0);
+            Format::template codec<CharT>::write(u_, s, string_terminator::none);
+            return s;
+        }
+
+        template <UuidFormat Format = format::standard, class CharT = char>
+        constexpr uuid_basic_fixed_string<CharT, Format::length> to_chars() const {
+            uuid_basic_fixed_string<CharT, Format::length> s;
+            Format::template codec<CharT>::write(u_, std::span(s.data(), s.size() + 1), string_terminator::null);
+            return s;
+        }
+
         constexpr size_t write_bytes(std::span<uint8_t> bytes) const {
             return detail::uuid_binary_u8::store_to_bytes(u_, bytes);
         }
@@ -119,17 +249,47 @@ namespace fquuid
             return detail::uuid_binary_byte::store_to_bytes(u_, bytes);
         }
 
+        template <UuidLayout Layout>
+        constexpr size_t write_bytes(std::span<uint8_t> bytes) const {
+            return detail::uuid_basic_binary<uint8_t, Layout>::store_to_bytes(u_, bytes);
+        }
+
+        template <UuidLayout Layout>
+        constexpr size_t write_bytes(std::span<std::byte> bytes) const {
+            return detail::uuid_basic_binary<std::byte, Layout>::store_to_bytes(u_, bytes);
+        }
+
         template <ByteLike ByteT = std::byte>
+            requires (!UuidLayout<ByteT>)
         constexpr std::array<ByteT, 16> to_bytes() const {
             std::array<ByteT, 16> bytes;
             detail::uuid_basic_binary<ByteT>::store_to_bytes(u_, bytes);
             return bytes;
         }
 
-        size_t hash() const noexcept {
-            std::hash<detail::uuid_u128::value_type> h;
+        template <UuidLayout Layout, ByteLike ByteT = std::byte>
+        constexpr std::array<ByteT, 16> to_bytes() const {
+            std::array<ByteT, 16> bytes;
+            detail::uuid_basic_binary<ByteT, Layout>::store_to_bytes(u_, bytes);
+            return bytes;
+        }
 
-            return h(u_.upper()) ^ h(u_.lower());
+        constexpr size_t hash() const noexcept {
+            return static_cast<size_t>(u_.hash());
+        }
+
+        constexpr size_t hash(uint64_t seed) const noexcept {
+            return static_cast<size_t>(u_.hash(seed));
+        }
+
+        // 122 random bits of a v4 UUID used as is, only for keys from a trusted random source
+        constexpr size_t hash_trusted_v4() const noexcept {
+            return static_cast<size_t>(u_.upper() ^ u_.lower());
+        }
+
+        // hash() of the 74 random bits of a v7 UUID: the timestamp does not take part
+        constexpr size_t hash_v7_random() const noexcept {
+            return static_cast<size_t>(detail::uuid_u128{ u_.upper() & 0xffff, u_.lower() }.hash());
         }
     };
 
@@ -139,6 +299,28 @@ namespace fquuid
         u.write_string(buf);
         return os << buf.data();
     }
+
+    // Reads xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx straight from the stream buffer
+    template <class CharT, class Traits>
+    auto& operator >>(std::basic_istream<CharT, Traits>& is, uuid& u) {
+        typename std::basic_istream<CharT, Traits>::sentry sentry(is);
+        if (!sentry)
+            return is;
+
+        std::array<CharT, 36> buf;
+        auto n = is.rdbuf()->sgetn(buf.data(), buf.size());
+        if (n != static_cast<std::streamsize>(buf.size())) {
+            is.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+            return is;
+        }
+
+        detail::uuid_u128 x {};
+        if (detail::uuid_basic_string<CharT>::try_parse_standard(x, buf))
+            u = uuid{x};
+        else
+            is.setstate(std::ios_base::failbit);
+        return is;
+    }
 }
 
 namespace std
@@ -150,4 +332,62 @@ namespace std
             return u.hash();
         }
     };
+
+#ifdef __cpp_lib_format
+    // Format spec: any of X (upper case), n (no dashes), b (braces), u (urn:uuid:)
+    template <class CharT>
+    struct formatter<fquuid::uuid, CharT>
+    {
+    private:
+        using hex_flags = fquuid::format::hex_flags;
+
+        hex_flags flags_ = hex_flags::none;
+
+        template <hex_flags Flags, class FormatContext>
+        static auto format_as(const fquuid::uuid& u, FormatContext& ctx) {
+            auto s = u.to_chars<fquuid::format::hex<Flags>, CharT>();
+            return std::copy(s.begin(), s.end(), ctx.out());
+        }
+
+    public:
+        constexpr auto parse(basic_format_parse_context<CharT>& ctx) {
+            auto it = ctx.begin();
+            for (; it != ctx.end() && *it != '}'; ++it) {
+                hex_flags f;
+                switch (*it) {
+                case 'X': f = hex_flags::upper; break;
+                case 'n': f = hex_flags::no_dashes; break;
+                case 'b': f = hex_flags::braces; break;
+                case 'u': f = hex_flags::urn; break;
+                default: throw format_error("fquuid: invalid format specifier");
+                }
+                if (fquuid::format::has_flag(flags_, f))
+                    throw format_error("fquuid: duplicate format specifier");
+                flags_ = flags_ | f;
+            }
+            if (fquuid::format::has_flag(flags_, hex_flags::braces) &&
+                fquuid::format::has_flag(flags_, hex_flags::urn))
+                throw format_error("fquuid: braces and urn cannot be combined");
+            return it;
+        }
+
+        template <class FormatContext>
+        auto format(const fquuid::uuid& u, FormatContext& ctx) const {
+            switch (static_cast<unsigned>(flags_)) {
+            case 0x0: return format_as<static_cast<hex_flags>(0x0)>(u, ctx);
+            case 0x1: return format_as<static_cast<hex_flags>(0x1)>(u, ctx);
+            case 0x2: return format_as<static_cast<hex_flags>(0x2)>(u, ctx);
+            case 0x3: return format_as<static_cast<hex_flags>(0x3)>(u, ctx);
+            case 0x4: return format_as<static_cast<hex_flags>(0x4)>(u, ctx);
+            case 0x5: return format_as<static_cast<hex_flags>(0x5)>(u, ctx);
+            case 0x6: return format_as<static_cast<hex_flags>(0x6)>(u, ctx);
+            case 0x7: return format_as<static_cast<hex_flags>(0x7)>(u, ctx);
+            case 0x8: return format_as<static_cast<hex_flags>(0x8)>(u, ctx);
+            case 0x9: return format_as<static_cast<hex_flags>(0x9)>(u, ctx);
+            case 0xa: return format_as<static_cast<hex_flags>(0xa)>(u, ctx);
+            default:  return format_as<static_cast<hex_flags>(0xb)>(u, ctx);
+            }
+        }
+    };
+#endif
 }
@@ -0,0 +1,425 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_types.hpp"
+#include "fquuid_simd.hpp"
+
+namespace fquuid::detail
+{
+    // A v7 uuid is 48 timestamp bits, version 7, 12 random bits (rand_a), variant 0b10 and 62 random bits (rand_b).
+    // A packed block stores the fields apart:
+    //   timestamps as zigzag deltas from the previous key, bit-packed at the widest delta's width
+    //   rand_b with the low 2 bits of rand_a in place of the variant, 8 bytes per key
+    //   the upper 10 bits of rand_a bit-packed
+    // so a sorted column costs 9.25 bytes per key plus a few bits of timestamp delta.
+    // Blocks holding anything but v7 uuids of the RFC variant are stored raw, 16 bytes per key.
+    //
+    // Bit-packed values are spread over 4 lanes (key i in lane i % 4) with the lanes' 64-bit words interleaved,
+    // so the AVX2 decoder unpacks 4 keys with one load and two shifts at the same bit offset.
+    struct uuid_v7_column_format
+    {
+        // "FQUUIDC1", key count, block size, block count, then block count + 1 byte offsets, then blocks
+        static constexpr std::array<char, 8> magic { 'F', 'Q', 'U', 'U', 'I', 'D', 'C', '1' };
+        static constexpr size_t header_size = 32;
+        static constexpr size_t max_block_size = size_t{1} << 20;
+
+        // block: count | mode << 32 | timestamp bits << 40, first timestamp, then the streams (all 64-bit words)
+        static constexpr size_t block_header_size = 16;
+        static constexpr uint64_t mode_packed = 0;
+        static constexpr uint64_t mode_raw = 1;
+
+        static constexpr int lanes = 4;
+        static constexpr int rand_a_bits = 10;
+        static constexpr uint64_t rand_b_mask = (uint64_t{1} << 62) - 1;
+        static constexpr uint64_t version_bits = 0x7000;
+        static constexpr uint64_t variant_bits = uint64_t{2} << 62;
+
+        // words of one bit-packed stream holding n values of w bits
+        static constexpr size_t stream_words(size_t n, int w) noexcept {
+            auto per_lane = (n + lanes - 1) / lanes;
+            return lanes * ((per_lane * static_cast<size_t>(w) + 63) / 64);
+        }
+
+        static constexpr size_t packed_size(size_t n, int ts_bits) noexcept {
+            return block_header_size + 8 * (stream_words(n, ts_bits) + stream_words(n, rand_a_bits) + n);
+        }
+
+        static constexpr size_t raw_size(size_t n) noexcept {
+            return block_header_size + 16 * n;
+        }
+
+        static constexpr uint64_t zigzag(int64_t d) noexcept {
+            return (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63);
+        }
+
+        static constexpr int64_t unzigzag(uint64_t z) noexcept {
+            return static_cast<int64_t>(z >> 1) ^ -static_cast<int64_t>(z & 1);
+        }
+
+        // load_le(p, 8) as a single load where the host is little-endian
+        static uint64_t load_word(const std::byte* p) noexcept {
+            if constexpr (std::endian::native == std::endian::little) {
+                uint64_t v;
+                std::memcpy(&v, p, 8);
+                return v;
+            }
+            else
+                return load_le(p, 8);
+        }
+
+        static constexpr uint64_t low_mask(int w) noexcept {
+            return w == 64 ? ~uint64_t{0} : (uint64_t{1} << w) - 1;
+        }
+
+        static void pack(uint64_t* words, std::span<const uint64_t> values, int w) noexcept {
+            if (w == 0)
+                return;
+            for (size_t i = 0; i < values.size(); i++) {
+                auto bit = (i / lanes) * static_cast<size_t>(w);
+                auto word = lanes * (bit / 64) + i % lanes;
+                auto off = static_cast<int>(bit % 64);
+                words[word] |= values[i] << off;
+                if (off + w > 64)
+                    words[word + lanes] |= values[i] >> (64 - off);
+            }
+        }
+
+        // value i of a stream written by pack
+        static uint64_t unpack(const std::byte* stream, size_t i, int w) noexcept {
+            if (w == 0)
+                return 0;
+            auto bit = (i / lanes) * static_cast<size_t>(w);
+            auto p = stream + 8 * (lanes * (bit / 64) + i % lanes);
+            auto off = static_cast<int>(bit % 64);
+            auto v = load_word(p) >> off;
+            if (off + w > 64)
+                v |= load_word(p + 8 * lanes) << (64 - off);
+            return v & low_mask(w);
+        }
+
+        // values 4k .. 4k + 3 of a stream written by pack
+        static void unpack_row(const std::byte* stream, size_t k, int w, uint64_t mask, uint64_t* v) noexcept {
+            if (w == 0) {
+                std::fill_n(v, lanes, 0);
+                return;
+            }
+            auto bit = k * static_cast<size_t>(w);
+            auto p = stream + 8 * lanes * (bit / 64);
+            auto off = static_cast<int>(bit % 64);
+            for (int l = 0; l < lanes; l++) {
+                v[l] = load_word(p + 8 * l) >> off;
+                if (off + w > 64)
+                    v[l] |= load_word(p + 8 * (lanes + l)) << (64 - off);
+                v[l] &= mask;
+            }
+        }
+
+        static void encode_block(std::span<const uuid> keys, std::vector<std::byte>& out) {
+            auto n = keys.size();
+            bool packed = true;
+            for (auto& u : keys) {
+                auto [hi, lo] = std::bit_cast<std::array<uint64_t, 2>>(u);
+                packed = packed && (hi & 0xf000) == version_bits && (lo & ~rand_b_mask) == variant_bits;
+            }
+
+            auto base = out.size();
+            if (!packed) {
+                out.resize(base + raw_size(n));
+                auto p = out.data() + base;
+                store_le(p, n | mode_raw << 32, 8);
+                store_le(p + 8, 0, 8);
+                p += block_header_size;
+                for (auto& u : keys) {
+                    auto [hi, lo] = std::bit_cast<std::array<uint64_t, 2>>(u);
+                    store_le(p, hi, 8);
+                    store_le(p + 8, lo, 8);
+                    p += 16;
+                }
+                return;
+            }
+
+            std::vector<uint64_t> deltas(n), rand_a(n), rand_b(n);
+            uint64_t first = n == 0 ? 0 : std::bit_cast<std::array<uint64_t, 2>>(keys[0])[0] >> 16;
+            uint64_t prev = first, widest = 0;
+            for (size_t i = 0; i < n; i++) {
+                auto [hi, lo] = std::bit_cast<std::array<uint64_t, 2>>(keys[i]);
+                auto ts = hi >> 16;
+                deltas[i] = zigzag(static_cast<int64_t>(ts - prev));
+                widest |= deltas[i];
+                prev = ts;
+                rand_a[i] = (hi & 0xfff) >> 2;
+                rand_b[i] = (lo & rand_b_mask) | (hi & 3) << 62;
+            }
+            auto ts_bits = std::bit_width(widest);
+
+            std::vector<uint64_t> words(stream_words(n, ts_bits) + stream_words(n, rand_a_bits));
+            pack(words.data(), deltas, ts_bits);
+            pack(words.data() + stream_words(n, ts_bits), rand_a, rand_a_bits);
+            words.insert(words.end(), rand_b.begin(), rand_b.end());
+
+            out.resize(base + packed_size(n, ts_bits));
+            auto p = out.data() + base;
+            store_le(p, n | mode_packed << 32 | static_cast<uint64_t>(ts_bits) << 40, 8);
+            store_le(p + 8, first, 8);
+            p += block_header_size;
+            for (auto w : words) {
+                store_le(p, w, 8);
+                p += 8;
+            }
+        }
+
+        // block bytes validated by uuid_v7_column_view
+        static void decode_block(const std::byte* block, std::span<uuid> out) noexcept {
+            auto head = load_word(block);
+            auto n = static_cast<size_t>(head & 0xffff'ffff);
+            auto p = block + block_header_size;
+
+            if ((head >> 32 & 0xff) == mode_raw) {
+                for (size_t i = 0; i < n; i++, p += 16)
+                    out[i] = std::bit_cast<uuid>(std::array<uint64_t, 2>{ load_word(p), load_word(p + 8) });
+                return;
+            }
+
+            auto ts_bits = static_cast<int>(head >> 40 & 0xff);
+            auto ts = load_word(block + 8);
+            auto ts_stream = p;
+            auto ra_stream = ts_stream + 8 * stream_words(n, ts_bits);
+            auto rb = ra_stream + 8 * stream_words(n, rand_a_bits);
+
+            size_t i = 0;
+#if defined(FQUUID_SIMD_AVX2)
+            if constexpr (std::endian::native == std::endian::little)
+                i = decode_avx2(ts_stream, ra_stream, rb, n, ts_bits, ts, out);
+#endif
+            // the same bit offset for the 4 lanes of a row
+            auto ts_mask = low_mask(ts_bits);
+            for (; i + lanes <= n; i += lanes) {
+                uint64_t d[lanes], ra[lanes];
+                unpack_row(ts_stream, i / lanes, ts_bits, ts_mask, d);
+                unpack_row(ra_stream, i / lanes, rand_a_bits, low_mask(rand_a_bits), ra);
+                for (int l = 0; l < lanes; l++) {
+                    ts += static_cast<uint64_t>(unzigzag(d[l]));
+                    auto b = load_word(rb + 8 * (i + l));
+                    auto hi = ts << 16 | version_bits | ra[l] << 2 | b >> 62;
+                    auto lo = (b & rand_b_mask) | variant_bits;
+                    out[i + l] = std::bit_cast<uuid>(std::array<uint64_t, 2>{ hi, lo });
+                }
+            }
+            for (; i < n; i++) {
+                ts += static_cast<uint64_t>(unzigzag(unpack(ts_stream, i, ts_bits)));
+                auto b = load_word(rb + 8 * i);
+                auto hi = ts << 16 | version_bits | unpack(ra_stream, i, rand_a_bits) << 2 | b >> 62;
+                auto lo = (b & rand_b_mask) | variant_bits;
+                out[i] = std::bit_cast<uuid>(std::array<uint64_t, 2>{ hi, lo });
+            }
+        }
+
+#if defined(FQUUID_SIMD_AVX2)
+        // 4 values of a stream starting at lane row k
+        static __m256i unpack4(const std::byte* stream, size_t k, int w, __m256i mask) noexcept {
+            auto bit = k * static_cast<size_t>(w);
+            auto p = reinterpret_cast<const __m256i*>(stream + 32 * (bit / 64));
+            auto off = static_cast<int>(bit % 64);
+            auto v = _mm256_srl_epi64(_mm256_loadu_si256(p), _mm_cvtsi32_si128(off));
+            if (off + w > 64)
+                v = _mm256_or_si256(v, _mm256_sll_epi64(_mm256_loadu_si256(p + 1), _mm_cvtsi32_si128(64 - off)));
+            return _mm256_and_si256(v, mask);
+        }
+
+        // decodes the complete groups of 4, returns the number of keys decoded
+        static size_t decode_avx2(const std::byte* ts_stream, const std::byte* ra_stream, const std::byte* rb,
+                                  size_t n, int ts_bits, uint64_t& ts, std::span<uuid> out) noexcept {
+            auto ts_mask = _mm256_set1_epi64x(static_cast<int64_t>(low_mask(ts_bits)));
+            auto ra_mask = _mm256_set1_epi64x(static_cast<int64_t>(low_mask(rand_a_bits)));
+            auto one = _mm256_set1_epi64x(1);
+            auto zero = _mm256_setzero_si256();
+            auto version = _mm256_set1_epi64x(static_cast<int64_t>(version_bits));
+            auto variant = _mm256_set1_epi64x(static_cast<int64_t>(variant_bits));
+            auto rb_mask = _mm256_set1_epi64x(static_cast<int64_t>(rand_b_mask));
+            auto dst = reinterpret_cast<__m256i*>(out.data());
+
+            size_t k = 0;
+            for (; 4 * k + 4 <= n; k++) {
+                auto d = ts_bits == 0 ? zero : unpack4(ts_stream, k, ts_bits, ts_mask);
+                // unzigzag, then prefix sum across the 4 lanes
+                d = _mm256_xor_si256(_mm256_srli_epi64(d, 1), _mm256_sub_epi64(zero, _mm256_and_si256(d, one)));
+                d = _mm256_add_epi64(d, _mm256_blend_epi32(_mm256_permute4x64_epi64(d, 0x90), zero, 0x03));
+                d = _mm256_add_epi64(d, _mm256_blend_epi32(_mm256_permute4x64_epi64(d, 0x40), zero, 0x0f));
+                auto t = _mm256_add_epi64(d, _mm256_set1_epi64x(static_cast<int64_t>(ts)));
+                ts = static_cast<uint64_t>(_mm256_extract_epi64(t, 3));
+
+                auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rb + 32 * k));
+                auto ra = _mm256_slli_epi64(unpack4(ra_stream, k, rand_a_bits, ra_mask), 2);
+                auto hi = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi64(t, 16), version),
+                                          _mm256_or_si256(ra, _mm256_srli_epi64(b, 62)));
+                auto lo = _mm256_or_si256(_mm256_and_si256(b, rb_mask), variant);
+
+                // {hi, lo} pairs in key order
+                auto a = _mm256_unpacklo_epi64(hi, lo);
+                auto c = _mm256_unpackhi_epi64(hi, lo);
+                _mm256_storeu_si256(dst + 2 * k, _mm256_permute2x128_si256(a, c, 0x20));
+                _mm256_storeu_si256(dst + 2 * k + 1, _mm256_permute2x128_si256(a, c, 0x31));
+            }
+            return 4 * k;
+        }
+#endif
+    };
+}
+
+namespace fquuid
+{
+    // Encodes keys into a column of independently decodable blocks of block_size keys.
+    // Any uuids are accepted; sorted or nearly sorted v7 keys take 9.3 to 10 bytes each.
+    inline std::vector<std::byte> encode_v7_column(std::span<const uuid> keys, size_t block_size = 1024) {
+        using format = detail::uuid_v7_column_format;
+        if (block_size == 0 || block_size > format::max_block_size)
+            throw std::invalid_argument("fquuid:encode_v7_column: invalid block size");
+
+        auto blocks = (keys.size() + block_size - 1) / block_size;
+        std::vector<std::byte> out(format::header_size + 8 * (blocks + 1));
+        std::copy(format::magic.begin(), format::magic.end(), reinterpret_cast<char*>(out.data()));
+        detail::store_le(out.data() + 8, keys.size(), 8);
+        detail::store_le(out.data() + 16, block_size, 8);
+        detail::store_le(out.data() + 24, blocks, 8);
+
+        for (size_t b = 0; b < blocks; b++) {
+            detail::store_le(out.data() + format::header_size + 8 * b, out.size(), 8);
+            format::encode_block(keys.subspan(b * block_size, std::min(block_size, keys.size() - b * block_size)), out);
+        }
+        detail::store_le(out.data() + format::header_size + 8 * blocks, out.size(), 8);
+        return out;
+    }
+
+    // Read access to a column written by encode_v7_column, e.g. in a uuid_mapped_file.
+    // The bytes are validated once on construction and must outlive the view.
+    class uuid_v7_column_view
+    {
+        using format = detail::uuid_v7_column_format;
+
+        std::span<const std::byte> bytes_;
+        size_t size_ = 0;
+        size_t block_size_ = 1;
+        size_t block_count_ = 0;
+
+        [[noreturn]] static void invalid() {
+            throw std::invalid_argument("fquuid:uuid_v7_column_view: invalid column data");
+        }
+
+        size_t offset(size_t b) const noexcept {
+            return static_cast<size_t>(format::load_word(bytes_.data() + format::header_size + 8 * b));
+        }
+
+    public:
+        uuid_v7_column_view() = default;
+
+        explicit uuid_v7_column_view(std::span<const std::byte> bytes) : bytes_(bytes) {
+            if (bytes.size() < format::header_size + 8
+                || !std::equal(format::magic.begin(), format::magic.end(), reinterpret_cast<const char*>(bytes.data())))
+                invalid();
+            auto size = format::load_word(bytes.data() + 8);
+            auto block_size = format::load_word(bytes.data() + 16);
+            auto blocks = format::load_word(bytes.data() + 24);
+            if (size > bytes.size() || block_size == 0 || block_size > format::max_block_size
+                || blocks != (size + block_size - 1) / block_size
+                || blocks + 1 > (bytes.size() - format::header_size) / 8)
+                invalid();
+            size_ = static_cast<size_t>(size);
+            block_size_ = static_cast<size_t>(block_size);
+            block_count_ = static_cast<size_t>(blocks);
+
+            if (offset(0) != format::header_size + 8 * (block_count_ + 1) || offset(block_count_) != bytes.size())
+                invalid();
+            for (size_t b = 0; b < block_count_; b++) {
+                auto first = offset(b), last = offset(b + 1);
+                if (last < first || last - first < format::block_header_size)
+                    invalid();
+                auto head = format::load_word(bytes.data() + first);
+                auto n = static_cast<size_t>(head & 0xffff'ffff);
+                auto mode = head >> 32 & 0xff;
+                auto ts_bits = static_cast<int>(head >> 40 & 0xff);
+                if (n != block_length(b) || head >> 48 != 0)
+                    invalid();
+                if (mode == format::mode_raw ? last - first != format::raw_size(n)
+                    : mode != format::mode_packed || ts_bits > 64 || last - first != format::packed_size(n, ts_bits))
+                    invalid();
+            }
+        }
+
+        size_t size() const noexcept { return size_; }
+        bool empty() const noexcept { return size_ == 0; }
+        size_t block_size() const noexcept { return block_size_; }
+        size_t block_count() const noexcept { return block_count_; }
+
+        // keys in block b, block_size() except for the last block
+        size_t block_length(size_t b) const noexcept {
+            return std::min(block_size_, size_ - b * block_size_);
+        }
+
+        // the encoded column
+        std::span<const std::byte> bytes() const noexcept {
+            return bytes_;
+        }
+
+        // writes the keys of block b to out, returns their number
+        size_t decode_block(size_t b, std::span<uuid> out) const {
+            if (b >= block_count_)
+                throw std::out_of_range("fquuid:uuid_v7_column_view: block index out of range");
+            auto n = block_length(b);
+            if (out.size() < n)
+                throw std::invalid_argument("fquuid:decode_block: output span size insufficient");
+            format::decode_block(bytes_.data() + offset(b), out);
+            return n;
+        }
+
+        void decode(std::span<uuid> out) const {
+            if (out.size() < size_)
+                throw std::invalid_argument("fquuid:decode: output span size insufficient");
+            for (size_t b = 0; b < block_count_; b++)
+                format::decode_block(bytes_.data() + offset(b), out.subspan(b * block_size_));
+        }
+
+        std::vector<uuid> to_vector() const {
+            std::vector<uuid> v(size_);
+            decode(v);
+            return v;
+        }
+
+        // key i, decoding the timestamps of its block up to i
+        uuid operator [](size_t i) const noexcept {
+            auto block = bytes_.data() + offset(i / block_size_);
+            auto j = i % block_size_;
+            auto head = format::load_word(block);
+            auto n = static_cast<size_t>(head & 0xffff'ffff);
+            auto p = block + format::block_header_size;
+
+            if ((head >> 32 & 0xff) == format::mode_raw)
+                return std::bit_cast<uuid>(std::array<uint64_t, 2>{ format::load_word(p + 16 * j), format::load_word(p + 16 * j + 8) });
+
+            auto ts_bits = static_cast<int>(head >> 40 & 0xff);
+            auto ts = format::load_word(block + 8);
+            for (size_t k = 0; k <= j; k++)
+                ts += static_cast<uint64_t>(format::unzigzag(format::unpack(p, k, ts_bits)));
+            auto ra_stream = p + 8 * format::stream_words(n, ts_bits);
+            auto b = format::load_word(ra_stream + 8 * (format::stream_words(n, format::rand_a_bits) + j));
+            auto hi = ts << 16 | format::version_bits | format::unpack(ra_stream, j, format::rand_a_bits) << 2 | b >> 62;
+            auto lo = (b & format::rand_b_mask) | format::variant_bits;
+            return std::bit_cast<uuid>(std::array<uint64_t, 2>{ hi, lo });
+        }
+
+        uuid at(size_t i) const {
+            if (i >= size_)
+                throw std::out_of_range("fquuid:uuid_v7_column_view: index out of range");
+            return (*this)[i];
+        }
+    };
+}
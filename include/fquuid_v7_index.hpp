@@ -0,0 +1,181 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "fquuid_uuid.hpp"
+#include "fquuid_flat_map.hpp"
+#include "fquuid_sort.hpp"
+
+namespace fquuid
+{
+    // Sorted set of v7 uuids answering point lookups and timestamp range queries.
+    //
+    // The keys live in one sorted vector; every block-th key is copied into a fence array
+    // (1/64 of the data, stays in cache) that is searched by interpolating on unix_ts_ms
+    // and galloping from the guess, then one block is binary searched.
+    //
+    // Keys newer than every stored key are appended, the usual case for v7.
+    // Late keys (same millisecond from another generator, clock skew) wait in a hash set
+    // that is sorted and merged once it reaches 1/8 of the size, so inserts stay O(1) amortized.
+    class uuid_v7_index
+    {
+        static constexpr size_t block = 64;
+        static constexpr size_t min_pending = 1024;
+
+        std::vector<uuid> sorted_;
+        std::vector<uuid> fence_; // sorted_[i * block]
+        uuid_flat_set pending_; // every key < sorted_.back()
+
+        // smallest 128-bit value with this timestamp, whatever the version bits
+        static constexpr uuid ts_bound(int64_t unix_ts_ms) noexcept {
+            return uuid{detail::uuid_u128 { static_cast<uint64_t>(unix_ts_ms) << 16, 0 }};
+        }
+
+        static constexpr int64_t max_ts = int64_t{1} << 48;
+
+        void rebuild_fence() {
+            fence_.clear();
+            fence_.reserve(sorted_.size() / block + 1);
+            for (size_t i = 0; i < sorted_.size(); i += block)
+                fence_.push_back(sorted_[i]);
+        }
+
+        size_t pending_limit() const noexcept {
+            return std::max(min_pending, sorted_.size() / 8);
+        }
+
+        // first fence >= key
+        size_t fence_lower_bound(const uuid& key) const noexcept {
+            auto n = fence_.size();
+            if (n == 0 || !(fence_.front() < key))
+                return 0;
+            if (fence_.back() < key)
+                return n;
+
+            // fence_[0] < key <= fence_[n - 1]
+            auto t0 = fence_.front().get_unix_ts_ms();
+            auto t1 = fence_.back().get_unix_ts_ms();
+            auto t = std::clamp(key.get_unix_ts_ms(), t0, t1);
+            size_t guess = t1 == t0 ? 0 : static_cast<size_t>(static_cast<double>(t - t0) / static_cast<double>(t1 - t0) * static_cast<double>(n - 1));
+            guess = std::min(guess, n - 1);
+
+            // gallop to lo < key <= hi
+            size_t lo, hi;
+            if (fence_[guess] < key) {
+                lo = guess;
+                size_t step = 1;
+                for (hi = guess + 1; fence_[hi] < key; hi = std::min(lo + step, n - 1)) {
+                    lo = hi;
+                    step *= 2;
+                }
+            }
+            else {
+                hi = guess;
+                size_t step = 1;
+                for (lo = guess - 1; !(fence_[lo] < key); lo = hi - std::min(step, hi)) {
+                    hi = lo;
+                    step *= 2;
+                }
+            }
+            return static_cast<size_t>(std::lower_bound(fence_.begin() + lo + 1, fence_.begin() + hi, key) - fence_.begin());
+        }
+
+        // first sorted_ index >= key
+        size_t lower_index(const uuid& key) const noexcept {
+            auto f = fence_lower_bound(key);
+            if (f == 0)
+                return 0;
+            auto first = sorted_.begin() + (f - 1) * block;
+            auto last = sorted_.begin() + std::min(f * block, sorted_.size());
+            return static_cast<size_t>(std::lower_bound(first, last, key) - sorted_.begin());
+        }
+
+        bool contains_sorted(const uuid& key) const noexcept {
+            auto i = lower_index(key);
+            return i < sorted_.size() && sorted_[i] == key;
+        }
+
+    public:
+        using value_type = uuid;
+        using size_type = size_t;
+
+        uuid_v7_index() = default;
+
+        // sorts and removes duplicates
+        explicit uuid_v7_index(std::vector<uuid> keys) : sorted_(std::move(keys)) {
+            fquuid::sort(sorted_);
+            sorted_.erase(std::unique(sorted_.begin(), sorted_.end()), sorted_.end());
+            rebuild_fence();
+        }
+
+        size_t size() const noexcept { return sorted_.size() + pending_.size(); }
+        bool empty() const noexcept { return size() == 0; }
+
+        void reserve(size_t n) {
+            sorted_.reserve(n);
+            fence_.reserve(n / block + 1);
+        }
+
+        void clear() noexcept {
+            sorted_.clear();
+            fence_.clear();
+            pending_.clear();
+        }
+
+        // returns false when the key was already present
+        bool insert(const uuid& key) {
+            if (sorted_.empty() || sorted_.back() < key) {
+                if (sorted_.size() % block == 0)
+                    fence_.push_back(key);
+                sorted_.push_back(key);
+                return true;
+            }
+
+            if (contains_sorted(key) || !pending_.insert(key).second)
+                return false;
+
+            if (pending_.size() > pending_limit())
+                flush();
+            return true;
+        }
+
+        bool contains(const uuid& key) const noexcept {
+            return contains_sorted(key) || pending_.contains(key);
+        }
+
+        // merges the late keys into the sorted vector
+        void flush() {
+            if (pending_.empty())
+                return;
+            auto n = sorted_.size();
+            sorted_.insert(sorted_.end(), pending_.begin(), pending_.end());
+            fquuid::sort(std::span(sorted_).subspan(n));
+            std::inplace_merge(sorted_.begin(), sorted_.begin() + n, sorted_.end());
+            pending_.clear();
+            rebuild_fence();
+        }
+
+        // every key, sorted
+        std::span<const uuid> keys() {
+            flush();
+            return sorted_;
+        }
+
+        // keys with from_ms <= unix_ts_ms < to_ms, sorted
+        std::span<const uuid> range(int64_t from_ms, int64_t to_ms) {
+            flush();
+            from_ms = std::clamp<int64_t>(from_ms, 0, max_ts);
+            to_ms = std::clamp<int64_t>(to_ms, 0, max_ts);
+            if (from_ms >= to_ms)
+                return {};
+
+            auto first = lower_index(ts_bound(from_ms));
+            auto last = to_ms == max_ts ? sorted_.size() : lower_index(ts_bound(to_ms));
+            return std::span<const uuid>(sorted_).subspan(first, last - first);
+        }
+    };
+}
@@ -0,0 +1,150 @@
+// Copyright 2025 granz.fisherman@gmail.com
+// https://opensource.org/license/mit
+#pragma once
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include "fquuid_uuid.hpp"
+
+namespace fquuid
+{
+    // Non-owning reference to 16 big-endian bytes owned elsewhere (mapped files, network buffers).
+    // The bytes are read in place; ordering is memcmp order, which equals uuid ordering.
+    class uuid_view
+    {
+        const std::byte* p_;
+
+        constexpr detail::uuid_u128 words() const {
+            detail::uuid_u128 u {};
+            detail::uuid_binary_byte::load_from_bytes(u, bytes());
+            return u;
+        }
+
+        static constexpr int compare_bytes(const std::byte* a, const std::byte* b) noexcept {
+            if (std::is_constant_evaluated()) {
+                for (size_t i = 0; i < 16; i++) {
+                    if (a[i] != b[i])
+                        return a[i] < b[i] ? -1 : 1;
+                }
+                return 0;
+            }
+            return std::memcmp(a, b, 16);
+        }
+
+    public:
+        constexpr explicit uuid_view(std::span<const std::byte, 16> bytes) noexcept
+            : p_(bytes.data()) {}
+
+        explicit uuid_view(std::span<const uint8_t, 16> bytes) noexcept
+            : p_(reinterpret_cast<const std::byte*>(bytes.data())) {}
+
+        // index-th record of consecutive 16-byte records
+        static constexpr uuid_view at(std::span<const std::byte> records, size_t index) {
+            if (index >= records.size() / 16)
+                throw std::out_of_range("fquuid:uuid_view: record index out of range");
+            return uuid_view(records.subspan(index * 16).first<16>());
+        }
+
+        constexpr std::span<const std::byte, 16> bytes() const noexcept {
+            return std::span<const std::byte, 16>(p_, 16);
+        }
+
+        constexpr uuid to_uuid() const {
+            return uuid::from_bytes<layout::big_endian>(std::span<const std::byte>(bytes()));
+        }
+
+        constexpr explicit operator uuid() const {
+            return to_uuid();
+        }
+
+        constexpr bool is_nil() const noexcept {
+            for (size_t i = 0; i < 16; i++) {
+                if (p_[i] != std::byte{0})
+                    return false;
+            }
+            return true;
+        }
+
+        constexpr uint8_t get_version() const noexcept {
+            return std::to_integer<uint8_t>(p_[6]) >> 4;
+        }
+
+        constexpr uint8_t get_variant() const noexcept {
+            return std::to_integer<uint8_t>(p_[8]) >> 6;
+        }
+
+        constexpr size_t write_string(std::span<char> s, string_terminator term = string_terminator::null) const {
+            return detail::uuid_string::write(words(), s, term);
+        }
+
+        constexpr size_t write_string(std::span<wchar_t> s, string_terminator term = string_terminator::null) const {
+            return detail::uuid_wstring::write(words(), s, term);
+        }
+
+        constexpr size_t write_string(std::span<char8_t> s, string_terminator term = string_terminator::null) const {
+            return detail::uuid_u8string::write(words(), s, term);
+        }
+
+        constexpr size_t write_string(std::span<char16_t> s, string_terminator term = string_terminator::null) const {
+            return detail::uuid_u16string::write(words(), s, term);
+        }
+
+        constexpr size_t write_string(std::span<char32_t> s, string_terminator term = string_terminator::null) const {
+            return detail::uuid_u32string::write(words(), s, term);
+        }
+
+        template <class String = std::string>
+        String to_string() const {
+            using CharT = typename String::value_type;
+
+            String s(36, 0);
+            detail::uuid_basic_string<CharT>::write(words(), s, string_terminator::none);
+            return s;
+        }
+
+        template <UuidFormat Format = format::standard, class CharT = char>
+        constexpr uuid_basic_fixed_string<CharT, Format::length> to_chars() const {
+            uuid_basic_fixed_string<CharT, Format::length> s;
+            Format::template codec<CharT>::write(words(), std::span(s.data(), s.size() + 1), string_terminator::null);
+            return s;
+        }
+
+        // same value as uuid::hash()
+        constexpr size_t hash() const noexcept {
+            return static_cast<size_t>(words().hash());
+        }
+
+        friend constexpr bool operator ==(const uuid_view& a, const uuid_view& b) noexcept {
+            return compare_bytes(a.p_, b.p_) == 0;
+        }
+
+        friend constexpr std::strong_ordering operator <=>(const uuid_view& a, const uuid_view& b) noexcept {
+            return compare_bytes(a.p_, b.p_) <=> 0;
+        }
+
+        friend constexpr bool operator ==(const uuid_view& a, const uuid& b) {
+            return a.to_uuid() == b;
+        }
+
+        friend constexpr std::strong_ordering operator <=>(const uuid_view& a, const uuid& b) {
+            return a.to_uuid() <=> b;
+        }
+    };
+}
+
+namespace std
+{
+    template <>
+    struct hash<fquuid::uuid_view>
+    {
+        size_t operator()(const fquuid::uuid_view& u) const noexcept {
+            return u.hash();
+        }
+    };
+}
@@ -1,5 +1,6 @@
 // Copyright 2024 granz.fisherman@gmail.com
 // https://opensource.org/license/mit
+#include <cstring>
 #include <boost/version.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -41,6 +42,7 @@ public:
 
     uuid_type gen_v4_mt() { return mt(); }
     uuid_type gen_v7_mt() { throw fquuid::not_implemented(); }
+    uuid_type gen_v7_at(int64_t) { throw fquuid::not_implemented(); }
 
     uuid_type parse(const std::string& s) { return sg(s); }
 
@@ -52,6 +54,8 @@ public:
         throw fquuid::not_implemented();
     }
 
+    std::array<char, 37> to_chars(const uuid_type&) { throw fquuid::not_implemented(); }
+
     uuid_type load_bytes(const array_type& a) {
         uuid_type u;
         std::copy(a.begin(), a.end(), u.begin());
@@ -61,6 +65,91 @@ public:
     void to_bytes(const uuid_type& u, array_type& a) {
         std::copy(u.begin(), u.end(), a.begin());
     }
+
+    void load_bytes_bulk(const std::vector<array_type>& in, std::vector<uuid_type>& out) {
+        std::memcpy(out.data(), in.data(), in.size() * 16);
+    }
+
+    void to_bytes_bulk(const std::vector<uuid_type>& in, std::vector<array_type>& out) {
+        std::memcpy(out.data(), in.data(), in.size() * 16);
+    }
+
+    size_t count_less_view(const uuid_type&, const std::vector<array_type>&) { throw fquuid::not_implemented(); }
+
+    size_t hash(const uuid_type& u) { return std::hash<uuid_type>{}(u); }
+    size_t hash_seeded(const uuid_type&) { throw fquuid::not_implemented(); }
+    size_t hash_trusted_v4(const uuid_type&) { throw fquuid::not_implemented(); }
+
+    bool flat_set_insert(const uuid_type&) { throw fquuid::not_implemented(); }
+    void flat_set_clear() { throw fquuid::not_implemented(); }
+    void flat_set_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t flat_set_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t flat_set_find_many(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+
+    void concurrent_map_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t dictionary_intern(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t dictionary_intern_many(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void concurrent_dictionary_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    bool concurrent_dictionary_intern(const uuid_type&) { throw fquuid::not_implemented(); }
+    bool concurrent_map_find(const uuid_type&) { throw fquuid::not_implemented(); }
+    void concurrent_map_write(const uuid_type&, uint64_t) { throw fquuid::not_implemented(); }
+    void atomic_store(const uuid_type&) { throw fquuid::not_implemented(); }
+    uuid_type atomic_load() { throw fquuid::not_implemented(); }
+    void atomic_replace(const uuid_type&) { throw fquuid::not_implemented(); }
+
+    void static_set_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t static_set_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t static_set_find_many(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void prefix_index_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t prefix_index_resolve(const std::vector<std::string>&) { throw fquuid::not_implemented(); }
+    void route_jump(const std::vector<uuid_type>&, std::vector<uint32_t>&) { throw fquuid::not_implemented(); }
+    void route_jump_many(const std::vector<uuid_type>&, std::vector<uint32_t>&) { throw fquuid::not_implemented(); }
+    void route_rendezvous_many(const std::vector<uuid_type>&, std::vector<uint32_t>&) { throw fquuid::not_implemented(); }
+    void route_ring_many(const std::vector<uuid_type>&, std::vector<uint32_t>&) { throw fquuid::not_implemented(); }
+
+    void bloom_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t bloom_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t bloom_find_many(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void bloom_v4_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t bloom_v4_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void fuse_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t fuse_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t fuse_find_many(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+
+    void set_file_assign(const std::vector<uuid_type>&, size_t) { throw fquuid::not_implemented(); }
+    size_t set_file_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+
+    bool v7_index_insert(const uuid_type&) { throw fquuid::not_implemented(); }
+    void v7_index_clear() { throw fquuid::not_implemented(); }
+    void v7_index_assign(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t v7_index_find(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    size_t v7_index_range(const std::vector<uuid_type>&, int64_t) { throw fquuid::not_implemented(); }
+
+    size_t v7_column_encode(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void v7_column_decode(std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void arrow_export_loop(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void arrow_export(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void arrow_import(std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void pg_copy_text(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void pg_copy_write(const std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void pg_copy_read(std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void radix_sort(std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void parallel_radix_sort(std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+
+    void load_guid_bulk(const std::vector<array_type>&, std::vector<uuid_type>&) { throw fquuid::not_implemented(); }
+    void to_guid_bulk(const std::vector<uuid_type>&, std::vector<array_type>&) { throw fquuid::not_implemented(); }
+
+    void to_base64url(const uuid_type&, std::span<char>) { throw fquuid::not_implemented(); }
+    uuid_type parse_base64url(const std::string&) { throw fquuid::not_implemented(); }
+
+    void to_base32(const uuid_type&, std::span<char>) { throw fquuid::not_implemented(); }
+    uuid_type parse_base32(const std::string&) { throw fquuid::not_implemented(); }
+
+    void to_base58(const uuid_type&, std::span<char>) { throw fquuid::not_implemented(); }
+    uuid_type parse_base58(const std::string&) { throw fquuid::not_implemented(); }
+
+    size_t scan_uuids(const std::string&) { throw fquuid::not_implemented(); }
+    size_t stream_scan_uuids(const std::string&, size_t) { throw fquuid::not_implemented(); }
 };
 
 int main(int argc, char** argv)
@@ -1,6 +1,27 @@
 // Copyright 2024 granz.fisherman@gmail.com
 // https://opensource.org/license/mit
 #include <fquuid.hpp>
+#include <fquuid_arrow.hpp>
+#include <fquuid_atomic.hpp>
+#include <fquuid_bulk.hpp>
+#include <fquuid_concurrent_map.hpp>
+#include <fquuid_dictionary.hpp>
+#include <fquuid_filter.hpp>
+#include <fquuid_flat_map.hpp>
+#include <fquuid_hash.hpp>
+#include <fquuid_pg_copy.hpp>
+#include <fquuid_prefix_index.hpp>
+#include <fquuid_routing.hpp>
+#include <fquuid_scanner.hpp>
+#include <fquuid_set_file.hpp>
+#include <fquuid_sort.hpp>
+#include <fquuid_static_set.hpp>
+#include <fquuid_v7_column.hpp>
+#include <fquuid_v7_index.hpp>
+#include <fquuid_view.hpp>
+#include <cstring>
+#include <filesystem>
+#include <optional>
 #include "fquuid_perf_test.hpp"
 
 class fquuid_impl
@@ -8,24 +29,368 @@ class fquuid_impl
     fquuid::uuid_generator_v4 v4;
     fquuid::uuid_generator_v7 v7;
     std::mt19937 mt; // [INSECURE] for performance test
+    fquuid::uuid_seeded_hash seeded_hash;
+    fquuid::uuid_flat_set flat_set;
+    fquuid::uuid_concurrent_map<uint64_t> concurrent_map;
+    fquuid::atomic_uuid atomic;
+    fquuid::uuid_dictionary dictionary;
+    ArrowSchema arrow_schema{};
+    std::vector<std::byte> pg_copy_buffer = std::vector<std::byte>(65536);
+    std::vector<std::byte> pg_copy_data;
+    ArrowArray arrow_array{};
+    std::vector<std::byte> v7_column;
+    std::vector<uint32_t> dictionary_ids;
+    std::unique_ptr<fquuid::uuid_concurrent_dictionary> concurrent_dictionary;
+    fquuid::uuid_v7_index v7_index;
+    fquuid::uuid_prefix_index prefix_index;
+    fquuid::uuid_jump_router jump_router{100};
+    fquuid::uuid_rendezvous_router rendezvous_router{100};
+    fquuid::uuid_bounded_load_ring ring{100};
+    std::optional<fquuid::uuid_set_file> set_file;
+    fquuid::uuid_static_set static_set;
+    fquuid::uuid_bloom_filter bloom{0};
+    fquuid::uuid_basic_bloom_filter<fquuid::uuid_trusted_v4_hash> bloom_v4{0};
+    fquuid::uuid_fuse_filter fuse;
 
 public:
     using uuid_type = fquuid::uuid;
     using array_type = std::array<uint8_t, 16>;
 
+    ~fquuid_impl() { arrow_release(); }
+
     uuid_type gen_v4() { return v4(); }
     uuid_type gen_v7() { return v7(); }
 
     uuid_type gen_v4_mt() { return fquuid::uuid_generator_v4::generate(mt); }
     uuid_type gen_v7_mt() { return fquuid::uuid_generator_v7::generate(mt); }
+    uuid_type gen_v7_at(int64_t ms) { return fquuid::uuid_generator_v7::generate(mt, ms); }
 
     uuid_type parse(const std::string& s) { return uuid_type{s}; }
 
     std::string to_string(const uuid_type& u) { return u.to_string(); }
     void to_string(const uuid_type& u, std::span<char> s) { u.write_string(s, fquuid::string_terminator::none); }
+    fquuid::uuid_fixed_string to_chars(const uuid_type& u) { return u.to_chars(); }
 
     uuid_type load_bytes(const array_type& a) { return uuid_type{a}; }
     void to_bytes(const uuid_type& u, array_type& a) { u.write_bytes(a); }
+
+    void arrow_release() {
+        if (arrow_array.release)
+            arrow_array.release(&arrow_array);
+        if (arrow_schema.release)
+            arrow_schema.release(&arrow_schema);
+    }
+
+    // the per-element copy a hand-written exporter does
+    void arrow_export_loop(const std::vector<uuid_type>& in) {
+        arrow_release();
+        std::vector<std::byte> bytes(16 * in.size());
+        for (size_t i = 0; i < in.size(); i++)
+            in[i].write_bytes(std::span(bytes).subspan(16 * i, 16));
+        fquuid::export_arrow_schema(&arrow_schema);
+        fquuid::export_arrow_array(std::move(bytes), &arrow_array);
+    }
+
+    void arrow_export(const std::vector<uuid_type>& in) {
+        arrow_release();
+        fquuid::export_arrow_schema(&arrow_schema);
+        fquuid::export_arrow_array(in, &arrow_array);
+    }
+
+    void arrow_import(std::vector<uuid_type>& out) { fquuid::import_arrow(arrow_schema, arrow_array, out); }
+
+    // text COPY: 36 characters and a newline per row, flushed in 64 KiB buffers
+    void pg_copy_text(const std::vector<uuid_type>& in) {
+        auto p = reinterpret_cast<char*>(pg_copy_buffer.data());
+        size_t n = 0;
+        for (auto& u : in) {
+            if (pg_copy_buffer.size() - n < 37)
+                n = 0;
+            std::memcpy(p + n, u.to_chars().data(), 36);
+            p[n + 36] = '\n';
+            n += 37;
+        }
+    }
+
+    // binary COPY in 64 KiB buffers, the last round kept for pg_copy_read
+    void pg_copy_write(const std::vector<uuid_type>& in) {
+        fquuid::uuid_pg_copy_writer writer;
+        pg_copy_data.resize(19 + writer.row_size() * in.size() + 2);
+        auto n = writer.write_header(pg_copy_data);
+        for (size_t i = 0; i < in.size();) {
+            auto r = writer.write_rows(std::span(in).subspan(i), pg_copy_buffer);
+            std::memcpy(pg_copy_data.data() + n, pg_copy_buffer.data(), r.bytes);
+            n += r.bytes;
+            i += r.values;
+        }
+        writer.write_trailer(std::span(pg_copy_data).subspan(n));
+    }
+
+    void pg_copy_read(std::vector<uuid_type>& out) {
+        fquuid::uuid_pg_copy_reader reader;
+        reader.read(pg_copy_data, out);
+    }
+
+    void load_bytes_bulk(const std::vector<array_type>& in, std::vector<uuid_type>& out) {
+        fquuid::load_many(std::span(in.data()->data(), in.size() * 16), out);
+    }
+
+    void to_bytes_bulk(const std::vector<uuid_type>& in, std::vector<array_type>& out) {
+        fquuid::store_many(in, std::span(out.data()->data(), out.size() * 16));
+    }
+
+    // records are compared in place without conversion to uuid
+    size_t count_less_view(const uuid_type& lhs, const std::vector<array_type>& in) {
+        auto a = lhs.to_bytes();
+        fquuid::uuid_view l{a};
+        size_t n = 0;
+        for (auto& r : in)
+            n += l < fquuid::uuid_view{r};
+        return n;
+    }
+
+    size_t hash(const uuid_type& u) { return std::hash<uuid_type>{}(u); }
+    size_t hash_seeded(const uuid_type& u) { return seeded_hash(u); }
+    size_t hash_trusted_v4(const uuid_type& u) { return fquuid::uuid_trusted_v4_hash{}(u); }
+
+    bool flat_set_insert(const uuid_type& u) { return flat_set.insert(u).second; }
+    void flat_set_clear() { flat_set.clear(); }
+
+    void flat_set_assign(const std::vector<uuid_type>& keys) {
+        flat_set.clear();
+        flat_set.reserve(keys.size());
+        for (auto& u : keys)
+            flat_set.insert(u);
+    }
+
+    size_t flat_set_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += flat_set.contains(u);
+        return n;
+    }
+
+    size_t flat_set_find_many(const std::vector<uuid_type>& lookup) {
+        std::array<bool, 256> found;
+        size_t n = 0;
+        for (size_t i = 0; i < lookup.size(); i += found.size()) {
+            auto keys = std::span(lookup).subspan(i, std::min(found.size(), lookup.size() - i));
+            n += flat_set.find_many(keys, found);
+        }
+        return n;
+    }
+
+    void concurrent_map_assign(const std::vector<uuid_type>& keys) {
+        concurrent_map.clear();
+        for (auto& u : keys)
+            concurrent_map.try_emplace(u, 0);
+    }
+
+    size_t dictionary_intern(const std::vector<uuid_type>& stream) {
+        dictionary.clear();
+        dictionary_ids.resize(stream.size());
+        for (size_t i = 0; i < stream.size(); i++)
+            dictionary_ids[i] = dictionary.intern(stream[i]);
+        return dictionary.size();
+    }
+
+    size_t dictionary_intern_many(const std::vector<uuid_type>& stream) {
+        dictionary.clear();
+        dictionary_ids.resize(stream.size());
+        return dictionary.intern_many(stream, dictionary_ids);
+    }
+
+    void concurrent_dictionary_assign(const std::vector<uuid_type>& keys) {
+        concurrent_dictionary = std::make_unique<fquuid::uuid_concurrent_dictionary>();
+        for (auto& u : keys)
+            concurrent_dictionary->intern(u);
+    }
+
+    bool concurrent_dictionary_intern(const uuid_type& u) {
+        return concurrent_dictionary->intern(u) != fquuid::uuid_concurrent_dictionary::npos;
+    }
+
+    bool concurrent_map_find(const uuid_type& u) { return concurrent_map.find(u).has_value(); }
+    void concurrent_map_write(const uuid_type& u, uint64_t v) { concurrent_map.insert_or_assign(u, v); }
+
+    void atomic_store(const uuid_type& u) { atomic.store(u); }
+    uuid_type atomic_load() { return atomic.load(std::memory_order_acquire); }
+
+    void atomic_replace(const uuid_type& u) {
+        auto expected = atomic.load(std::memory_order_relaxed);
+        while (!atomic.compare_exchange_weak(expected, u, std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+    }
+
+    void static_set_assign(const std::vector<uuid_type>& keys) { static_set = fquuid::uuid_static_set{keys}; }
+
+    size_t static_set_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += static_set.contains(u);
+        return n;
+    }
+
+    void prefix_index_assign(const std::vector<uuid_type>& keys) { prefix_index = fquuid::uuid_prefix_index{keys}; }
+
+    size_t prefix_index_resolve(const std::vector<std::string>& prefixes) {
+        size_t n = 0;
+        for (auto& p : prefixes)
+            n += prefix_index.resolve(p).has_value();
+        return n;
+    }
+
+    void route_jump(const std::vector<uuid_type>& keys, std::vector<uint32_t>& out) {
+        for (size_t i = 0; i < keys.size(); i++)
+            out[i] = jump_router.route(keys[i]);
+    }
+
+    void route_jump_many(const std::vector<uuid_type>& keys, std::vector<uint32_t>& out) { jump_router.route_many(keys, out); }
+    void route_rendezvous_many(const std::vector<uuid_type>& keys, std::vector<uint32_t>& out) { rendezvous_router.route_many(keys, out); }
+    void route_ring_many(const std::vector<uuid_type>& keys, std::vector<uint32_t>& out) { ring.route_many(keys, out); }
+
+    size_t static_set_find_many(const std::vector<uuid_type>& lookup) {
+        std::array<bool, 256> found;
+        size_t n = 0;
+        for (size_t i = 0; i < lookup.size(); i += found.size()) {
+            auto keys = std::span(lookup).subspan(i, std::min(found.size(), lookup.size() - i));
+            n += static_set.contains_many(keys, found);
+        }
+        return n;
+    }
+
+    void bloom_assign(const std::vector<uuid_type>& keys) {
+        bloom = fquuid::uuid_bloom_filter{keys.size()};
+        bloom.insert(keys);
+    }
+
+    size_t bloom_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += bloom.may_contain(u);
+        return n;
+    }
+
+    size_t bloom_find_many(const std::vector<uuid_type>& lookup) {
+        std::array<bool, 256> found;
+        size_t n = 0;
+        for (size_t i = 0; i < lookup.size(); i += found.size()) {
+            auto keys = std::span(lookup).subspan(i, std::min(found.size(), lookup.size() - i));
+            n += bloom.may_contain_many(keys, found);
+        }
+        return n;
+    }
+
+    void bloom_v4_assign(const std::vector<uuid_type>& keys) {
+        bloom_v4 = fquuid::uuid_basic_bloom_filter<fquuid::uuid_trusted_v4_hash>{keys.size()};
+        bloom_v4.insert(keys);
+    }
+
+    size_t bloom_v4_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += bloom_v4.may_contain(u);
+        return n;
+    }
+
+    void fuse_assign(const std::vector<uuid_type>& keys) { fuse = fquuid::uuid_fuse_filter{keys}; }
+
+    size_t fuse_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += fuse.may_contain(u);
+        return n;
+    }
+
+    size_t fuse_find_many(const std::vector<uuid_type>& lookup) {
+        std::array<bool, 256> found;
+        size_t n = 0;
+        for (size_t i = 0; i < lookup.size(); i += found.size()) {
+            auto keys = std::span(lookup).subspan(i, std::min(found.size(), lookup.size() - i));
+            n += fuse.may_contain_many(keys, found);
+        }
+        return n;
+    }
+
+    // written to the temporary directory, run_keys = keys.size() keeps a single run in memory
+    void set_file_assign(const std::vector<uuid_type>& keys, size_t run_keys) {
+        auto path = std::filesystem::temp_directory_path() / "fquuid_perf_test.fqs";
+        set_file.reset();
+        fquuid::uuid_set_file_writer w{path, run_keys};
+        w.add(keys);
+        w.finish();
+        set_file.emplace(path);
+        std::error_code ec;
+        std::filesystem::remove(path, ec); // unix keeps the mapping, windows keeps the file until the next call
+    }
+
+    size_t set_file_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += set_file->contains(u);
+        return n;
+    }
+
+    bool v7_index_insert(const uuid_type& u) { return v7_index.insert(u); }
+    void v7_index_clear() { v7_index.clear(); }
+    void v7_index_assign(const std::vector<uuid_type>& keys) { v7_index = fquuid::uuid_v7_index{keys}; }
+
+    size_t v7_index_find(const std::vector<uuid_type>& lookup) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += v7_index.contains(u);
+        return n;
+    }
+
+    // [ts, ts + window_ms) around each lookup key
+    size_t v7_index_range(const std::vector<uuid_type>& lookup, int64_t window_ms) {
+        size_t n = 0;
+        for (auto& u : lookup)
+            n += v7_index.range(u.get_unix_ts_ms(), u.get_unix_ts_ms() + window_ms).size();
+        return n;
+    }
+
+    size_t v7_column_encode(const std::vector<uuid_type>& keys) {
+        v7_column = fquuid::encode_v7_column(keys);
+        return v7_column.size();
+    }
+
+    void v7_column_decode(std::vector<uuid_type>& out) { fquuid::uuid_v7_column_view(v7_column).decode(out); }
+
+    void radix_sort(std::vector<uuid_type>& v) { fquuid::sort(v); }
+    void parallel_radix_sort(std::vector<uuid_type>& v) { fquuid::parallel_sort(v); }
+
+    void load_guid_bulk(const std::vector<array_type>& in, std::vector<uuid_type>& out) {
+        fquuid::load_many<fquuid::layout::guid>(std::span(in.data()->data(), in.size() * 16), out);
+    }
+
+    void to_guid_bulk(const std::vector<uuid_type>& in, std::vector<array_type>& out) {
+        fquuid::store_many<fquuid::layout::guid>(in, std::span(out.data()->data(), out.size() * 16));
+    }
+
+    void to_base64url(const uuid_type& u, std::span<char> s) { u.write_string<fquuid::format::base64url>(s); }
+    uuid_type parse_base64url(const std::string& s) { return uuid_type::parse<fquuid::format::base64url>(s); }
+
+    void to_base32(const uuid_type& u, std::span<char> s) { u.write_string<fquuid::format::base32>(s); }
+    uuid_type parse_base32(const std::string& s) { return uuid_type::parse<fquuid::format::base32>(s); }
+
+    void to_base58(const uuid_type& u, std::span<char> s) { u.write_string<fquuid::format::base58>(s); }
+    uuid_type parse_base58(const std::string& s) { return uuid_type::parse<fquuid::format::base58>(s); }
+
+    size_t scan_uuids(const std::string& text) {
+        size_t count = 0;
+        fquuid::scan_uuids(text, [&](const fquuid::uuid_match&) { count++; });
+        return count;
+    }
+
+    size_t stream_scan_uuids(const std::string& text, size_t piece) {
+        size_t count = 0;
+        auto fn = [&](const fquuid::uuid_match&) { count++; };
+        fquuid::uuid_stream_scanner scanner;
+        for (size_t i = 0; i < text.size(); i += piece)
+            scanner.feed(std::span(text).subspan(i, std::min(piece, text.size() - i)), fn);
+        scanner.finish(fn);
+        return count;
+    }
 };
 
 int main(int argc, char** argv)
@@ -1,14 +1,23 @@
 // Copyright 2024 granz.fisherman@gmail.com
 // https://opensource.org/license/mit
 #pragma once
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <exception>
+#include <iomanip>
 #include <iostream>
+#include <mutex>
+#include <random>
 #include <set>
+#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 #include "fquuid_ops_measure.hpp"
 
@@ -81,6 +90,25 @@ namespace fquuid
             });
         }
 
+        void test_to_chars() {
+            std::vector<uuid_t> in;
+            for (int i = 0; i < 1'000'000; i++)
+                in.push_back(impl.gen_v4_mt());
+
+            using chars_t = decltype(impl.to_chars(in[0]));
+            std::vector<chars_t> out{in.size()};
+
+            ops_measure ops{"to string (uuid_fixed_string)", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (size_t i = 0; i < in.size(); i++)
+                        out[i] = impl.to_chars(in[i]);
+
+                    ops_count += in.size();
+                }
+            });
+        }
+
         void test_load_bytes() {
             std::vector<array_t> in;
             for (int i = 0; i < 1'000'000; i++) {
@@ -120,6 +148,109 @@ namespace fquuid
             });
         }
 
+        template <class LoadFn>
+        void measure_load_bulk(const std::string& name, LoadFn load) {
+            std::vector<array_t> in;
+            for (int i = 0; i < 1'000'000; i++) {
+                array_t a;
+                impl.to_bytes(impl.gen_v4_mt(), a);
+                in.push_back(a);
+            }
+
+            std::vector<uuid_t> out{in.size()};
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    load(in, out);
+                    ops_count += in.size();
+                }
+            });
+        }
+
+        template <class StoreFn>
+        void measure_store_bulk(const std::string& name, StoreFn store) {
+            std::vector<uuid_t> in;
+            for (int i = 0; i < 1'000'000; i++)
+                in.push_back(impl.gen_v4_mt());
+
+            std::vector<array_t> out{in.size()};
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    store(in, out);
+                    ops_count += in.size();
+                }
+            });
+        }
+
+        void test_load_bytes_bulk() {
+            measure_load_bulk("load bytes (bulk)", [&](const auto& in, auto& out) { impl.load_bytes_bulk(in, out); });
+        }
+
+        void test_to_bytes_bulk() {
+            measure_store_bulk("to bytes (bulk)", [&](const auto& in, auto& out) { impl.to_bytes_bulk(in, out); });
+        }
+
+        void test_load_guid_bulk() {
+            measure_load_bulk("load guid bytes (bulk)", [&](const auto& in, auto& out) { impl.load_guid_bulk(in, out); });
+        }
+
+        void test_to_guid_bulk() {
+            measure_store_bulk("to guid bytes (bulk)", [&](const auto& in, auto& out) { impl.to_guid_bulk(in, out); });
+        }
+
+        // 1M keys through an export / import format, fn(keys, out)
+        template <class Fn>
+        void measure_column_io(const std::string& name, Fn fn) {
+            std::vector<uuid_t> keys, out(1'000'000);
+            for (int i = 0; i < 1'000'000; i++)
+                keys.push_back(impl.gen_v4_mt());
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    fn(keys, out);
+                    ops_count += keys.size();
+                }
+            });
+        }
+
+        void test_export_arrow_loop() {
+            measure_column_io("export arrow (write_bytes loop)", [&](const auto& keys, auto&) { impl.arrow_export_loop(keys); });
+        }
+
+        void test_export_arrow() {
+            measure_column_io("export arrow", [&](const auto& keys, auto&) { impl.arrow_export(keys); });
+        }
+
+        void test_import_arrow() {
+            bool exported = false;
+            measure_column_io("import arrow", [&](const auto& keys, auto& out) {
+                if (!std::exchange(exported, true))
+                    impl.arrow_export(keys);
+                impl.arrow_import(out);
+            });
+        }
+
+        void test_pg_copy_text() {
+            measure_column_io("pg copy text write", [&](const auto& keys, auto&) { impl.pg_copy_text(keys); });
+        }
+
+        void test_pg_copy_write() {
+            measure_column_io("pg copy binary write", [&](const auto& keys, auto&) { impl.pg_copy_write(keys); });
+        }
+
+        void test_pg_copy_read() {
+            bool written = false;
+            measure_column_io("pg copy binary read", [&](const auto& keys, auto& out) {
+                if (!std::exchange(written, true))
+                    impl.pg_copy_write(keys);
+                impl.pg_copy_read(out);
+            });
+        }
+
         void test_compare() {
             std::vector<uuid_t> in;
             for (int i = 0; i < 1'000'000; i++)
@@ -143,6 +274,235 @@ namespace fquuid
                 throw std::runtime_error("Compare ops_count error");
         }
 
+        void test_compare_view() {
+            std::vector<array_t> in;
+            for (int i = 0; i < 1'000'000; i++) {
+                array_t a;
+                impl.to_bytes(impl.gen_v4_mt(), a);
+                in.push_back(a);
+            }
+
+            auto lhs = impl.gen_v4_mt();
+            uint_fast64_t cmp_count = 0;
+
+            ops_measure ops{"compare (view)", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    cmp_count += impl.count_less_view(lhs, in);
+                    ops_count += in.size();
+                }
+            });
+
+            if (cmp_count == 0)
+                throw std::runtime_error("Compare ops_count error");
+        }
+
+        // Linear probing in a power-of-two table at load factor 0.67,
+        // the layout where weak low bits of a hash hurt the most.
+        template <class GenFn, class HashFn>
+        void measure_probe(const std::string& name, GenFn gen, HashFn hash) {
+            constexpr size_t table_size = 1 << 20;
+            constexpr size_t mask = table_size - 1;
+
+            std::vector<uuid_t> in;
+            for (size_t i = 0; i < table_size * 2 / 3; i++)
+                in.push_back(gen());
+
+            std::vector<uint8_t> used(table_size);
+            uint_fast64_t total_probe = 0;
+            size_t max_probe = 0;
+
+            ops_measure ops{"hash table insert (" + name + ")", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    std::fill(used.begin(), used.end(), 0);
+                    total_probe = 0;
+                    max_probe = 0;
+                    for (auto& u : in) {
+                        size_t probe = 0;
+                        auto i = hash(u) & mask;
+                        for (; used[i]; i = (i + 1) & mask)
+                            probe++;
+                        used[i] = 1;
+                        total_probe += probe;
+                        max_probe = std::max(max_probe, probe);
+                    }
+                    ops_count += in.size();
+                }
+            });
+
+            std::ostringstream stat;
+            stat << std::fixed << std::setprecision(2)
+                 << static_cast<double>(total_probe) / in.size() << " / " << max_probe;
+            std::cout << std::setw(15) << ' ' << "\t"
+                      << std::setw(13) << stat.str() << "\t"
+                      << "probe avg / max (" << name << ")" << std::endl << std::flush;
+        }
+
+        void test_probe_v4() {
+            measure_probe("v4, std::hash", [&] { return impl.gen_v4_mt(); }, [&](const auto& u) { return impl.hash(u); });
+        }
+
+        void test_probe_v7() {
+            measure_probe("v7, std::hash", [&] { return impl.gen_v7(); }, [&](const auto& u) { return impl.hash(u); });
+        }
+
+        void test_probe_v4_seeded() {
+            measure_probe("v4, seeded", [&] { return impl.gen_v4_mt(); }, [&](const auto& u) { return impl.hash_seeded(u); });
+        }
+
+        void test_probe_v7_seeded() {
+            measure_probe("v7, seeded", [&] { return impl.gen_v7(); }, [&](const auto& u) { return impl.hash_seeded(u); });
+        }
+
+        void test_probe_v4_trusted() {
+            measure_probe("v4, trusted v4", [&] { return impl.gen_v4_mt(); }, [&](const auto& u) { return impl.hash_trusted_v4(u); });
+        }
+
+        template <class GenFn, class SortFn>
+        void measure_sort(const std::string& name, GenFn gen, SortFn sort) {
+            std::vector<uuid_t> in;
+            for (int i = 0; i < 1'000'000; i++)
+                in.push_back(gen());
+
+            std::vector<uuid_t> work;
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    work = in;
+                    sort(work);
+                    ops_count += work.size();
+                }
+            });
+
+            if (!std::is_sorted(work.begin(), work.end()))
+                throw std::runtime_error("Sort order error");
+        }
+
+        void test_sort() {
+            measure_sort("sort", [&] { return impl.gen_v4_mt(); }, [](auto& v) { std::sort(v.begin(), v.end()); });
+        }
+
+        void test_sort_radix() {
+            measure_sort("sort (radix)", [&] { return impl.gen_v4_mt(); }, [&](auto& v) { impl.radix_sort(v); });
+        }
+
+        void test_sort_radix_parallel() {
+            measure_sort("sort (radix, parallel)", [&] { return impl.gen_v4_mt(); }, [&](auto& v) { impl.parallel_radix_sort(v); });
+        }
+
+        void test_sort_v7() {
+            measure_sort("sort v7", [&] { return impl.gen_v7(); }, [](auto& v) { std::sort(v.begin(), v.end()); });
+        }
+
+        void test_sort_v7_radix() {
+            measure_sort("sort v7 (radix)", [&] { return impl.gen_v7(); }, [&](auto& v) { impl.radix_sort(v); });
+        }
+
+        template <class EncodeFn>
+        void measure_encode(const std::string& name, EncodeFn encode) {
+            std::vector<uuid_t> in;
+            for (int i = 0; i < 1'000'000; i++)
+                in.push_back(impl.gen_v4_mt());
+
+            std::vector<std::array<char, 40>> out{in.size()};
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (size_t i = 0; i < in.size(); i++)
+                        encode(in[i], out[i]);
+
+                    ops_count += in.size();
+                }
+            });
+        }
+
+        template <class EncodeFn, class DecodeFn>
+        void measure_decode(const std::string& name, EncodeFn encode, DecodeFn decode) {
+            std::vector<std::string> in;
+            for (int i = 0; i < 1'000'000; i++) {
+                std::array<char, 40> buf {};
+                encode(impl.gen_v4_mt(), buf);
+                in.push_back(buf.data());
+            }
+
+            std::vector<uuid_t> out{in.size()};
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (size_t i = 0; i < in.size(); i++)
+                        out[i] = decode(in[i]);
+
+                    ops_count += in.size();
+                }
+            });
+        }
+
+        void test_to_base64url() {
+            measure_encode("to base64url", [&](const auto& u, auto& s) { impl.to_base64url(u, s); });
+        }
+
+        void test_parse_base64url() {
+            measure_decode("parse base64url",
+                           [&](const auto& u, auto& s) { impl.to_base64url(u, s); },
+                           [&](auto& s) { return impl.parse_base64url(s); });
+        }
+
+        void test_to_base32() {
+            measure_encode("to base32", [&](const auto& u, auto& s) { impl.to_base32(u, s); });
+        }
+
+        void test_parse_base32() {
+            measure_decode("parse base32",
+                           [&](const auto& u, auto& s) { impl.to_base32(u, s); },
+                           [&](auto& s) { return impl.parse_base32(s); });
+        }
+
+        void test_to_base58() {
+            measure_encode("to base58", [&](const auto& u, auto& s) { impl.to_base58(u, s); });
+        }
+
+        void test_parse_base58() {
+            measure_decode("parse base58",
+                           [&](const auto& u, auto& s) { impl.to_base58(u, s); },
+                           [&](auto& s) { return impl.parse_base58(s); });
+        }
+
+        void test_scan_log() {
+            std::string text;
+            for (int i = 0; i < 100'000; i++) {
+                text += "2024-10-09T12:34:56.789Z INFO  http request_id=";
+                text += impl.to_string(impl.gen_v4_mt());
+                text += " method=GET path=/api/v1/items status=200 latency_ms=12\n";
+            }
+
+            size_t found = 0;
+
+            ops_measure ops{"scan uuids (log, byte)", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    found += impl.scan_uuids(text);
+                    ops_count += text.size();
+                }
+            });
+
+            if (found == 0)
+                throw std::runtime_error("Scan found no UUIDs");
+
+            size_t expected = impl.scan_uuids(text);
+            ops_measure stream{"scan uuids (log, 4 KiB pieces, byte)", measure_time_short};
+            stream.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    if (impl.stream_scan_uuids(text, 4096) != expected)
+                        throw std::runtime_error("Stream scan count error");
+                    ops_count += text.size();
+                }
+            });
+        }
+
         void test_generate_v4_mt19937() {
             std::vector<uuid_t> out{1'000'000};
 
@@ -253,6 +613,630 @@ namespace fquuid
             });
         }
 
+        void test_generate_v4_flat_set() {
+            impl.flat_set_clear();
+            constexpr int iteration = 100'000;
+
+            ops_measure ops{"generate v4 (default, uuid_flat_set)", measure_time_long};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (int i = 0; i < iteration; i++) {
+                        if (!impl.flat_set_insert(impl.gen_v4()))
+                            throw std::runtime_error("UUID collision detected. Please check the random number generation.");
+                    }
+
+                    ops_count += iteration;
+                }
+            });
+        }
+
+        void test_generate_v7_flat_set() {
+            impl.flat_set_clear();
+            constexpr int iteration = 100'000;
+
+            ops_measure ops{"generate v7 (default, uuid_flat_set)", measure_time_long};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (int i = 0; i < iteration; i++) {
+                        if (!impl.flat_set_insert(impl.gen_v7()))
+                            throw std::runtime_error("UUID collision detected. Please check the random number generation.");
+                    }
+
+                    ops_count += iteration;
+                }
+            });
+        }
+
+        // half of the lookups hit
+        template <class FindFn>
+        void measure_find(const std::string& name, FindFn find) {
+            std::vector<uuid_t> keys, lookup;
+            for (int i = 0; i < 1'000'000; i++) {
+                keys.push_back(impl.gen_v4_mt());
+                lookup.push_back(i % 2 ? keys.back() : impl.gen_v4_mt());
+            }
+
+            size_t found = 0;
+            find(keys, lookup, found, true);
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    find(keys, lookup, found, false);
+                    ops_count += lookup.size();
+                }
+            });
+
+            if (found != lookup.size() / 2)
+                throw std::runtime_error("Find count error");
+        }
+
+        void test_find_unordered_set() {
+            std::unordered_set<uuid_t> set;
+            measure_find("find (std::unordered_set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    set.insert(keys.begin(), keys.end());
+                    return;
+                }
+                found = 0;
+                for (auto& u : lookup)
+                    found += set.contains(u);
+            });
+        }
+
+        void test_find_flat_set() {
+            measure_find("find (uuid_flat_set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init)
+                    impl.flat_set_assign(keys);
+                else
+                    found = impl.flat_set_find(lookup);
+            });
+        }
+
+        void test_find_many_flat_set() {
+            measure_find("find_many (uuid_flat_set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init)
+                    impl.flat_set_assign(keys);
+                else
+                    found = impl.flat_set_find_many(lookup);
+            });
+        }
+
+        void test_find_set() {
+            std::set<uuid_t> set;
+            measure_find("find (std::set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    set.insert(keys.begin(), keys.end());
+                    return;
+                }
+                found = 0;
+                for (auto& u : lookup)
+                    found += set.contains(u);
+            });
+        }
+
+        void test_find_sorted_vector() {
+            std::vector<uuid_t> sorted;
+            measure_find("find (sorted vector)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    sorted = keys;
+                    std::sort(sorted.begin(), sorted.end());
+                    return;
+                }
+                found = 0;
+                for (auto& u : lookup)
+                    found += std::binary_search(sorted.begin(), sorted.end(), u);
+            });
+        }
+
+        void test_find_static_set() {
+            measure_find("find (uuid_static_set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init)
+                    impl.static_set_assign(keys);
+                else
+                    found = impl.static_set_find(lookup);
+            });
+        }
+
+        void test_find_many_static_set() {
+            measure_find("contains_many (uuid_static_set)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init)
+                    impl.static_set_assign(keys);
+                else
+                    found = impl.static_set_find_many(lookup);
+            });
+        }
+
+        // 10M keys, 1M lookups of absent keys: the prefilter case where most requests are new
+        template <class GenFn, class AssignFn, class QueryFn>
+        void measure_filter(const std::string& name, GenFn gen, AssignFn assign, QueryFn query) {
+            std::vector<uuid_t> keys, lookup;
+            for (int i = 0; i < 10'000'000; i++)
+                keys.push_back(gen(i));
+            for (int i = 0; i < 1'000'000; i++)
+                lookup.push_back(impl.gen_v4_mt());
+
+            {
+                ops_measure ops{"build (" + name + ")", measure_time_short};
+                ops.measure([&](auto token, auto& ops_count) {
+                    while (!token.stop_requested()) {
+                        assign(keys);
+                        ops_count += keys.size();
+                    }
+                });
+            }
+
+            size_t positives = 0;
+            {
+                ops_measure ops{"may_contain (" + name + ")", measure_time_short};
+                ops.measure([&](auto token, auto& ops_count) {
+                    while (!token.stop_requested()) {
+                        positives = query(lookup);
+                        ops_count += lookup.size();
+                    }
+                });
+            }
+
+            std::ostringstream stat;
+            stat << std::fixed << std::setprecision(3)
+                 << 100.0 * static_cast<double>(positives) / static_cast<double>(lookup.size()) << " %";
+            std::cout << std::setw(15) << ' ' << "\t"
+                      << std::setw(13) << stat.str() << "\t"
+                      << "false positives (" << name << ")" << std::endl << std::flush;
+        }
+
+        void test_filter_bloom() {
+            measure_filter("bloom, 10M v7", [&](int i) { return impl.gen_v7_at(1'700'000'000'000 + i / 1'000); },
+                [&](const auto& keys) { impl.bloom_assign(keys); },
+                [&](const auto& lookup) { return impl.bloom_find(lookup); });
+        }
+
+        void test_filter_bloom_many() {
+            measure_filter("bloom many, 10M v7", [&](int i) { return impl.gen_v7_at(1'700'000'000'000 + i / 1'000); },
+                [&](const auto& keys) { impl.bloom_assign(keys); },
+                [&](const auto& lookup) { return impl.bloom_find_many(lookup); });
+        }
+
+        void test_filter_bloom_v4() {
+            measure_filter("bloom trusted v4, 10M v4", [&](int) { return impl.gen_v4_mt(); },
+                [&](const auto& keys) { impl.bloom_v4_assign(keys); },
+                [&](const auto& lookup) { return impl.bloom_v4_find(lookup); });
+        }
+
+        void test_filter_fuse() {
+            measure_filter("fuse, 10M v7", [&](int i) { return impl.gen_v7_at(1'700'000'000'000 + i / 1'000); },
+                [&](const auto& keys) { impl.fuse_assign(keys); },
+                [&](const auto& lookup) { return impl.fuse_find(lookup); });
+        }
+
+        void test_filter_fuse_many() {
+            measure_filter("fuse many, 10M v7", [&](int i) { return impl.gen_v7_at(1'700'000'000'000 + i / 1'000); },
+                [&](const auto& keys) { impl.fuse_assign(keys); },
+                [&](const auto& lookup) { return impl.fuse_find_many(lookup); });
+        }
+
+        void test_find_set_file() {
+            measure_find("find (uuid_set_file)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init)
+                    impl.set_file_assign(keys, keys.size());
+                else
+                    found = impl.set_file_find(lookup);
+            });
+        }
+
+        // 1M keys spilled as 4 sorted runs and merged
+        void test_write_set_file() {
+            std::vector<uuid_t> keys;
+            for (int i = 0; i < 1'000'000; i++)
+                keys.push_back(impl.gen_v4_mt());
+
+            ops_measure ops{"write (uuid_set_file_writer, 4 runs)", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    impl.set_file_assign(keys, keys.size() / 4);
+                    ops_count += keys.size();
+                }
+            });
+        }
+
+        void test_generate_v7_index() {
+            impl.v7_index_clear();
+            constexpr int iteration = 100'000;
+
+            ops_measure ops{"generate v7 (default, uuid_v7_index)", measure_time_long};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    for (int i = 0; i < iteration; i++) {
+                        if (!impl.v7_index_insert(impl.gen_v7()))
+                            throw std::runtime_error("UUID collision detected. Please check the random number generation.");
+                    }
+
+                    ops_count += iteration;
+                }
+            });
+        }
+
+        // 1M v7 keys over 100 seconds, half of the point lookups hit
+        template <class QueryFn>
+        void measure_v7_query(const std::string& name, QueryFn query) {
+            constexpr int64_t base = 1'700'000'000'000;
+            std::vector<uuid_t> keys, lookup;
+            for (int i = 0; i < 1'000'000; i++) {
+                keys.push_back(impl.gen_v7_at(base + i / 10));
+                lookup.push_back(i % 2 ? keys.back() : impl.gen_v7_at(base + i / 10));
+            }
+            std::shuffle(lookup.begin(), lookup.end(), std::mt19937_64{});
+
+            size_t found = 0;
+            query(keys, lookup, found, true);
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    ops_count += query(keys, lookup, found, false);
+                }
+            });
+
+            if (found == 0)
+                throw std::runtime_error("Find count error");
+        }
+
+        void test_find_v7_sorted() {
+            std::vector<uuid_t> sorted;
+            measure_v7_query("find v7 (std::lower_bound)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    sorted = keys;
+                    std::sort(sorted.begin(), sorted.end());
+                    return size_t{0};
+                }
+                found = 0;
+                for (auto& u : lookup)
+                    found += std::binary_search(sorted.begin(), sorted.end(), u);
+                return lookup.size();
+            });
+        }
+
+        void test_find_v7_index() {
+            measure_v7_query("find v7 (uuid_v7_index)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    impl.v7_index_assign(keys);
+                    return size_t{0};
+                }
+                found = impl.v7_index_find(lookup);
+                return lookup.size();
+            });
+        }
+
+        // 10 ms windows, one query per lookup key
+        void test_range_v7_index() {
+            measure_v7_query("range v7 10 ms (uuid_v7_index)", [&](const auto& keys, const auto& lookup, auto& found, bool init) {
+                if (init) {
+                    impl.v7_index_assign(keys);
+                    return size_t{0};
+                }
+                found = impl.v7_index_range(lookup, 10);
+                return lookup.size();
+            });
+        }
+
+        // 1M v7 keys in generation order
+        void test_v7_column() {
+            std::vector<uuid_t> keys(1'000'000), decoded(1'000'000);
+            for (auto& u : keys)
+                u = impl.gen_v7();
+
+            size_t bytes = 0;
+            {
+                ops_measure ops{"encode v7 column", measure_time_short};
+                ops.measure([&](auto token, auto& ops_count) {
+                    while (!token.stop_requested()) {
+                        bytes = impl.v7_column_encode(keys);
+                        ops_count += keys.size();
+                    }
+                });
+            }
+            {
+                ops_measure ops{"decode v7 column", measure_time_short};
+                ops.measure([&](auto token, auto& ops_count) {
+                    while (!token.stop_requested()) {
+                        impl.v7_column_decode(decoded);
+                        ops_count += decoded.size();
+                    }
+                });
+            }
+            if (decoded != keys)
+                throw std::runtime_error("Decode error");
+
+            std::ostringstream stat;
+            stat << std::fixed << std::setprecision(2)
+                 << static_cast<double>(bytes) / static_cast<double>(keys.size()) << " B/key";
+            std::cout << std::setw(15) << ' ' << "\t"
+                      << std::setw(13) << stat.str() << "\t"
+                      << "size (v7 column)" << std::endl << std::flush;
+        }
+
+        // 1M keys, lookups by their first 8 hex digits, fn(keys, prefixes, init) returns the unique matches
+        template <class Fn>
+        void measure_prefix(const std::string& name, Fn fn) {
+            std::vector<uuid_t> keys;
+            std::vector<std::string> prefixes;
+            for (int i = 0; i < 1'000'000; i++) {
+                keys.push_back(impl.gen_v4_mt());
+                prefixes.push_back(impl.to_string(keys.back()).substr(0, 8));
+            }
+
+            size_t unique = fn(keys, prefixes, true);
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    if (fn(keys, prefixes, false) != unique)
+                        throw std::runtime_error("Resolve count error");
+                    ops_count += prefixes.size();
+                }
+            });
+        }
+
+        void test_resolve_prefix_sorted_strings() {
+            std::vector<std::string> sorted;
+            measure_prefix("resolve prefix (sorted strings)", [&](const auto& keys, const auto& prefixes, bool init) {
+                if (init) {
+                    for (auto& u : keys)
+                        sorted.push_back(impl.to_string(u));
+                    std::sort(sorted.begin(), sorted.end());
+                }
+                size_t n = 0;
+                for (auto& p : prefixes) {
+                    auto it = std::lower_bound(sorted.begin(), sorted.end(), p);
+                    n += it != sorted.end() && it->starts_with(p) && (it + 1 == sorted.end() || !(it + 1)->starts_with(p));
+                }
+                return n;
+            });
+        }
+
+        void test_resolve_prefix_index() {
+            measure_prefix("resolve prefix (uuid_prefix_index)", [&](const auto& keys, const auto& prefixes, bool init) {
+                if (init)
+                    impl.prefix_index_assign(keys);
+                return impl.prefix_index_resolve(prefixes);
+            });
+        }
+
+        // 1M keys onto 100 shards, fn(keys, out)
+        template <class Fn>
+        void measure_route(const std::string& name, Fn fn) {
+            std::vector<uuid_t> keys;
+            for (int i = 0; i < 1'000'000; i++)
+                keys.push_back(impl.gen_v4_mt());
+            std::vector<uint32_t> out(keys.size());
+
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    fn(keys, out);
+                    ops_count += keys.size();
+                }
+            });
+        }
+
+        void test_route_hash_modulo() {
+            measure_route("route 100 (std::hash modulo)", [&](const auto& keys, auto& out) {
+                std::hash<uuid_t> hash;
+                for (size_t i = 0; i < keys.size(); i++)
+                    out[i] = static_cast<uint32_t>(hash(keys[i]) % 100);
+            });
+        }
+
+        void test_route_jump() {
+            measure_route("route 100 (uuid_jump_router)", [&](const auto& keys, auto& out) { impl.route_jump(keys, out); });
+        }
+
+        void test_route_many_jump() {
+            measure_route("route_many 100 (uuid_jump_router)", [&](const auto& keys, auto& out) { impl.route_jump_many(keys, out); });
+        }
+
+        void test_route_many_rendezvous() {
+            measure_route("route_many 100 (uuid_rendezvous_router)", [&](const auto& keys, auto& out) { impl.route_rendezvous_many(keys, out); });
+        }
+
+        void test_route_many_ring() {
+            measure_route("route_many 100 (uuid_bounded_load_ring)", [&](const auto& keys, auto& out) { impl.route_ring_many(keys, out); });
+        }
+
+        // Threads pick keys from a prefilled table; write_percent of the operations overwrite a value.
+        template <class ReadFn, class WriteFn>
+        void measure_concurrent(const std::string& name, const std::vector<uuid_t>& keys,
+                                int write_percent, ReadFn read, WriteFn write) {
+            auto threads = std::max(4u, std::thread::hardware_concurrency());
+
+            ops_measure ops{name + ", " + std::to_string(threads) + " threads", measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                std::atomic<uint_fast64_t> total = 0;
+                std::atomic<uint_fast64_t> hits = 0;
+                {
+                    std::vector<std::jthread> workers;
+                    for (unsigned t = 0; t < threads; t++) {
+                        workers.emplace_back([&, t] {
+                            uint64_t x = 0x9e37'79b9'7f4a'7c15 * (t + 1);
+                            uint_fast64_t count = 0, hit = 0;
+                            while (!token.stop_requested()) {
+                                for (int i = 0; i < 1024; i++) {
+                                    x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                                    auto& k = keys[x % keys.size()];
+                                    if (static_cast<int>((x >> 32) % 100) < write_percent)
+                                        write(k, x);
+                                    else
+                                        hit += read(k);
+                                }
+                                count += 1024;
+                            }
+                            total += count;
+                            hits += hit;
+                        });
+                    }
+                }
+                ops_count += total;
+
+                if (hits == 0)
+                    throw std::runtime_error("Concurrent read count error");
+            });
+        }
+
+        template <class Fn>
+        void measure_concurrent_map(int write_percent, Fn run) {
+            std::vector<uuid_t> keys;
+            for (int i = 0; i < 1'000'000; i++)
+                keys.push_back(impl.gen_v4_mt());
+            run(keys, write_percent);
+        }
+
+        void run_concurrent_unordered_map(const std::vector<uuid_t>& keys, int write_percent) {
+            std::unordered_map<uuid_t, uint64_t> map;
+            std::mutex mutex;
+            for (auto& k : keys)
+                map.emplace(k, 0);
+
+            std::string mode = write_percent < 50 ? "read 95%" : "write 50%";
+            measure_concurrent("concurrent " + mode + " (std::unordered_map + mutex)", keys, write_percent,
+                [&](const uuid_t& k) {
+                    std::lock_guard lock(mutex);
+                    return map.find(k) != map.end();
+                },
+                [&](const uuid_t& k, uint64_t v) {
+                    std::lock_guard lock(mutex);
+                    map[k] = v;
+                });
+        }
+
+        void run_concurrent_map(const std::vector<uuid_t>& keys, int write_percent) {
+            impl.concurrent_map_assign(keys);
+
+            std::string mode = write_percent < 50 ? "read 95%" : "write 50%";
+            measure_concurrent("concurrent " + mode + " (uuid_concurrent_map)", keys, write_percent,
+                [&](const uuid_t& k) { return impl.concurrent_map_find(k); },
+                [&](const uuid_t& k, uint64_t v) { impl.concurrent_map_write(k, v); });
+        }
+
+        void test_concurrent_read_unordered_map() {
+            measure_concurrent_map(5, [&](const auto& keys, int w) { run_concurrent_unordered_map(keys, w); });
+        }
+
+        void test_concurrent_write_unordered_map() {
+            measure_concurrent_map(50, [&](const auto& keys, int w) { run_concurrent_unordered_map(keys, w); });
+        }
+
+        void test_concurrent_read_map() {
+            measure_concurrent_map(5, [&](const auto& keys, int w) { run_concurrent_map(keys, w); });
+        }
+
+        void test_concurrent_write_map() {
+            measure_concurrent_map(50, [&](const auto& keys, int w) { run_concurrent_map(keys, w); });
+        }
+
+        // One shared uuid: write_percent of the operations replace it by a compare-exchange loop, the rest load it
+        template <class Fn>
+        void measure_atomic(int write_percent, Fn run) {
+            std::vector<uuid_t> keys;
+            for (int i = 0; i < 1024; i++)
+                keys.push_back(impl.gen_v4_mt());
+            run(keys, write_percent);
+        }
+
+        void run_atomic_mutex(const std::vector<uuid_t>& keys, int write_percent) {
+            uuid_t shared = keys[0];
+            std::mutex mutex;
+
+            std::string mode = write_percent < 50 ? "read 95%" : "write 50%";
+            measure_concurrent("contended uuid " + mode + " (uuid + mutex)", keys, write_percent,
+                [&](const uuid_t& k) {
+                    std::lock_guard lock(mutex);
+                    return shared != k;
+                },
+                [&](const uuid_t& k, uint64_t) {
+                    std::lock_guard lock(mutex);
+                    shared = k;
+                });
+        }
+
+        void run_atomic_uuid(const std::vector<uuid_t>& keys, int write_percent) {
+            impl.atomic_store(keys[0]);
+
+            std::string mode = write_percent < 50 ? "read 95%" : "write 50%";
+            measure_concurrent("contended uuid " + mode + " (atomic_uuid)", keys, write_percent,
+                [&](const uuid_t& k) { return impl.atomic_load() != k; },
+                [&](const uuid_t& k, uint64_t) { impl.atomic_replace(k); });
+        }
+
+        void test_atomic_read_mutex() {
+            measure_atomic(5, [&](const auto& keys, int w) { run_atomic_mutex(keys, w); });
+        }
+
+        void test_atomic_write_mutex() {
+            measure_atomic(50, [&](const auto& keys, int w) { run_atomic_mutex(keys, w); });
+        }
+
+        void test_atomic_read_uuid() {
+            measure_atomic(5, [&](const auto& keys, int w) { run_atomic_uuid(keys, w); });
+        }
+
+        void test_atomic_write_uuid() {
+            measure_atomic(50, [&](const auto& keys, int w) { run_atomic_uuid(keys, w); });
+        }
+
+        // 1M distinct keys, each interned twice, into an emptied dictionary
+        template <class InternFn>
+        void measure_intern(const std::string& name, InternFn intern) {
+            std::vector<uuid_t> stream;
+            for (int i = 0; i < 1'000'000; i++)
+                stream.push_back(impl.gen_v4_mt());
+            stream.insert(stream.end(), stream.begin(), stream.begin() + 1'000'000);
+
+            size_t added = 0;
+            ops_measure ops{name, measure_time_short};
+            ops.measure([&](auto token, auto& ops_count) {
+                while (!token.stop_requested()) {
+                    added = intern(stream);
+                    ops_count += stream.size();
+                }
+            });
+
+            if (added != stream.size() / 2)
+                throw std::runtime_error("Intern count error");
+        }
+
+        void test_intern_unordered_map() {
+            std::unordered_map<uuid_t, uint32_t> ids;
+            std::vector<uuid_t> uuids;
+            std::vector<uint32_t> out(2'000'000);
+            measure_intern("intern (std::unordered_map + vector)", [&](const auto& stream) {
+                ids.clear();
+                uuids.clear();
+                for (size_t i = 0; i < stream.size(); i++) {
+                    auto [it, inserted] = ids.try_emplace(stream[i], static_cast<uint32_t>(uuids.size()));
+                    if (inserted)
+                        uuids.push_back(stream[i]);
+                    out[i] = it->second;
+                }
+                return uuids.size();
+            });
+        }
+
+        void test_intern_dictionary() {
+            measure_intern("intern (uuid_dictionary)", [&](const auto& stream) { return impl.dictionary_intern(stream); });
+        }
+
+        void test_intern_many_dictionary() {
+            measure_intern("intern_many (uuid_dictionary)", [&](const auto& stream) { return impl.dictionary_intern_many(stream); });
+        }
+
+        void test_concurrent_intern_dictionary() {
+            measure_concurrent_map(0, [&](const auto& keys, int w) {
+                impl.concurrent_dictionary_assign(keys);
+                measure_concurrent("concurrent intern (uuid_concurrent_dictionary)", keys, w,
+                    [&](const uuid_t& k) { return impl.concurrent_dictionary_intern(k); },
+                    [&](const uuid_t&, uint64_t) {});
+            });
+        }
+
         void test_generate_v7_unordered_set() {
             std::unordered_set<uuid_t> set;
             constexpr int iteration = 100'000;
@@ -277,9 +1261,38 @@ namespace fquuid
             &uuid_perf_test::test_parse,
             &uuid_perf_test::test_to_string,
             &uuid_perf_test::test_to_string_array,
+            &uuid_perf_test::test_to_chars,
             &uuid_perf_test::test_load_bytes,
             &uuid_perf_test::test_to_bytes,
+            &uuid_perf_test::test_load_bytes_bulk,
+            &uuid_perf_test::test_to_bytes_bulk,
+            &uuid_perf_test::test_load_guid_bulk,
+            &uuid_perf_test::test_to_guid_bulk,
+            &uuid_perf_test::test_export_arrow_loop,
+            &uuid_perf_test::test_export_arrow,
+            &uuid_perf_test::test_import_arrow,
+            &uuid_perf_test::test_pg_copy_text,
+            &uuid_perf_test::test_pg_copy_write,
+            &uuid_perf_test::test_pg_copy_read,
             &uuid_perf_test::test_compare,
+            &uuid_perf_test::test_compare_view,
+            &uuid_perf_test::test_sort,
+            &uuid_perf_test::test_sort_radix,
+            &uuid_perf_test::test_sort_radix_parallel,
+            &uuid_perf_test::test_sort_v7,
+            &uuid_perf_test::test_sort_v7_radix,
+            &uuid_perf_test::test_probe_v4,
+            &uuid_perf_test::test_probe_v7,
+            &uuid_perf_test::test_probe_v4_seeded,
+            &uuid_perf_test::test_probe_v7_seeded,
+            &uuid_perf_test::test_probe_v4_trusted,
+            &uuid_perf_test::test_to_base64url,
+            &uuid_perf_test::test_parse_base64url,
+            &uuid_perf_test::test_to_base32,
+            &uuid_perf_test::test_parse_base32,
+            &uuid_perf_test::test_to_base58,
+            &uuid_perf_test::test_parse_base58,
+            &uuid_perf_test::test_scan_log,
             &uuid_perf_test::test_generate_v4_mt19937,
             &uuid_perf_test::test_generate_v7_mt19937,
             &uuid_perf_test::test_generate_v4,
@@ -288,6 +1301,46 @@ namespace fquuid
             &uuid_perf_test::test_generate_v7_set,
             &uuid_perf_test::test_generate_v4_unordered_set,
             &uuid_perf_test::test_generate_v7_unordered_set,
+            &uuid_perf_test::test_generate_v4_flat_set,
+            &uuid_perf_test::test_generate_v7_flat_set,
+            &uuid_perf_test::test_find_unordered_set,
+            &uuid_perf_test::test_find_flat_set,
+            &uuid_perf_test::test_find_many_flat_set,
+            &uuid_perf_test::test_find_set,
+            &uuid_perf_test::test_find_sorted_vector,
+            &uuid_perf_test::test_find_static_set,
+            &uuid_perf_test::test_find_many_static_set,
+            &uuid_perf_test::test_find_set_file,
+            &uuid_perf_test::test_filter_bloom,
+            &uuid_perf_test::test_filter_bloom_many,
+            &uuid_perf_test::test_filter_bloom_v4,
+            &uuid_perf_test::test_filter_fuse,
+            &uuid_perf_test::test_filter_fuse_many,
+            &uuid_perf_test::test_write_set_file,
+            &uuid_perf_test::test_generate_v7_index,
+            &uuid_perf_test::test_find_v7_sorted,
+            &uuid_perf_test::test_find_v7_index,
+            &uuid_perf_test::test_range_v7_index,
+            &uuid_perf_test::test_v7_column,
+            &uuid_perf_test::test_resolve_prefix_sorted_strings,
+            &uuid_perf_test::test_resolve_prefix_index,
+            &uuid_perf_test::test_route_hash_modulo,
+            &uuid_perf_test::test_route_jump,
+            &uuid_perf_test::test_route_many_jump,
+            &uuid_perf_test::test_route_many_rendezvous,
+            &uuid_perf_test::test_route_many_ring,
+            &uuid_perf_test::test_concurrent_read_unordered_map,
+            &uuid_perf_test::test_concurrent_read_map,
+            &uuid_perf_test::test_concurrent_write_unordered_map,
+            &uuid_perf_test::test_concurrent_write_map,
+            &uuid_perf_test::test_atomic_read_mutex,
+            &uuid_perf_test::test_atomic_read_uuid,
+            &uuid_perf_test::test_atomic_write_mutex,
+            &uuid_perf_test::test_atomic_write_uuid,
+            &uuid_perf_test::test_intern_unordered_map,
+            &uuid_perf_test::test_intern_dictionary,
+            &uuid_perf_test::test_intern_many_dictionary,
+            &uuid_perf_test::test_concurrent_intern_dictionary,
         };
 
     public:
@@ -1,15 +1,40 @@
 // Copyright 2024 granz.fisherman@gmail.com
 // https://opensource.org/license/mit
 #include <fquuid.hpp>
+#include <fquuid_arrow.hpp>
+#include <fquuid_atomic.hpp>
+#include <fquuid_bulk.hpp>
+#include <fquuid_concurrent_map.hpp>
+#include <fquuid_dictionary.hpp>
+#include <fquuid_filter.hpp>
+#include <fquuid_flat_map.hpp>
+#include <fquuid_hash.hpp>
+#include <fquuid_pg_copy.hpp>
+#include <fquuid_prefix_index.hpp>
+#include <fquuid_routing.hpp>
+#include <fquuid_scanner.hpp>
+#include <fquuid_set_file.hpp>
+#include <fquuid_sort.hpp>
+#include <fquuid_static_set.hpp>
+#include <fquuid_v7_column.hpp>
+#include <fquuid_v7_index.hpp>
+#include <fquuid_view.hpp>
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <compare>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 using namespace fquuid;
 
@@ -79,6 +104,31 @@ static void test_compare()
     static_assert((a <=> b) < 0, "test_compare() #12");
     static_assert((b <=> a) > 0, "test_compare() #13");
     static_assert((a <=> d) == 0, "test_compare() #14");
+
+    // words compared as unsigned, upper word first
+    constexpr auto e = uuid{S("7fffffff-ffff-4fff-bfff-ffffffffffff")};
+    constexpr auto f = uuid{S("80000000-0000-4000-8000-000000000000")};
+    constexpr auto g = uuid{S("80000000-0000-4000-bfff-ffffffffffff")};
+
+    static_assert(e < f, "test_compare() #15");
+    static_assert(f < g, "test_compare() #16");
+    static_assert((g <=> e) > 0, "test_compare() #17");
+
+    static_assert(sizeof(uuid) == 16, "test_compare() #18");
+    static_assert(alignof(uuid) == 16, "test_compare() #19");
+
+    // non-constant evaluation takes the SIMD / 128-bit integer paths
+    std::vector<uuid> v {g, a, f, c, e, b, d};
+    runtime_assert(v[1] == v[6], "test_compare() #20");
+    runtime_assert(v[0] != v[2], "test_compare() #21");
+    runtime_assert((v[4] <=> v[2]) < 0, "test_compare() #22");
+    runtime_assert((v[0] <=> v[2]) > 0, "test_compare() #23");
+    runtime_assert((v[1] <=> v[6]) == 0, "test_compare() #24");
+
+    std::sort(v.begin(), v.end());
+    runtime_assert(std::is_sorted(v.begin(), v.end(), std::less<>{}), "test_compare() #25");
+    runtime_assert(v.front() == a && v.back() == g, "test_compare() #26");
+    runtime_assert((std::vector<uuid> {a, d, b, c, e, f, g}) == v, "test_compare() #27");
 }
 
 static void test_random()
@@ -115,6 +165,12 @@ static void test_time()
     runtime_assert(a.to_string().substr(0, 13) == "01926c01-ba2c", "test_time() #1");
     runtime_assert(b.to_string().substr(0, 13) == "01926c01-ba2c", "test_time() #2");
     runtime_assert(a != b, "test_time() #3");
+    runtime_assert(a.get_unix_ts_ms() == 0x01926c01'ba2c, "test_time() #4");
+
+    static_assert(uuid_v7_min(0x01926c01'ba2c) == uuid{S("01926c01-ba2c-7000-8000-000000000000")}, "test_time() #5");
+    static_assert(uuid_v7_max(0x01926c01'ba2c) == uuid{S("01926c01-ba2c-7fff-bfff-ffffffffffff")}, "test_time() #6");
+    static_assert(uuid_v7_max(0x01926c01'ba2c) < uuid_v7_min(0x01926c01'ba2d), "test_time() #7");
+    runtime_assert(uuid_v7_min(0x01926c01'ba2c) <= a && a <= uuid_v7_max(0x01926c01'ba2c), "test_time() #8");
 }
 
 static void test_parse()
@@ -366,6 +422,28 @@ static void test_string_error()
     catch (std::invalid_argument&) {}
 }
 
+static void test_fixed_string()
+{
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    static constexpr auto s1 = a.to_chars<format::standard, CharT>();
+    constexpr auto s2 = a.to_chars<format::braced, CharT>();
+    constexpr std::basic_string_view<CharT> sv = s1;
+    constexpr const CharT* ptr = s1;
+    auto s3 = a.to_chars();
+
+    static_assert(s1.size() == 36, "test_fixed_string() #1");
+    static_assert(s2.size() == 38, "test_fixed_string() #2");
+    static_assert(sv == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_fixed_string() #3");
+    static_assert(s1 == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_fixed_string() #4");
+    static_assert(s2 == S("{d604557f-6739-4883-b627-bc0a81b84e97}"), "test_fixed_string() #5");
+    static_assert(ptr[36] == 0, "test_fixed_string() #6");
+    static_assert(uuid{s1.c_str()} == a, "test_fixed_string() #7");
+    runtime_assert(String(s1) == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_fixed_string() #8");
+    runtime_assert(s3 == "d604557f-6739-4883-b627-bc0a81b84e97", "test_fixed_string() #9");
+    runtime_assert(std::string(s3.begin(), s3.end()) == a.to_string(), "test_fixed_string() #10");
+    static_assert(std::is_same_v<decltype(s3), uuid_fixed_string>, "test_fixed_string() #11");
+}
+
 static void test_ostream()
 {
     constexpr auto a = uuid{S("d604557f67394883b627bc0a81b84e97")};
@@ -376,6 +454,357 @@ static void test_ostream()
     runtime_assert(oss.str() == S("{d604557f-6739-4883-b627-bc0a81b84e97}"), "test_ostream() #1");
 }
 
+static void test_string_format()
+{
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    constexpr auto s_array = [&] {
+        std::array<CharT, 40> buf;
+        std::ranges::fill(buf, S('*'));
+        auto wrote = a.write_string<format::combine<format::upper, format::braced>>(buf);
+        runtime_assert(wrote == 39, "test_string_format() #1");
+        return buf;
+    }();
+
+    using upper_hex32 = format::combine<format::upper, format::hex32>;
+    using upper_urn = format::combine<format::urn, format::upper>;
+
+    String s1 = a.to_string<format::standard, String>();
+    String s2 = a.to_string<format::upper, String>();
+    String s3 = a.to_string<format::hex32, String>();
+    String s4 = a.to_string<format::braced, String>();
+    String s5 = a.to_string<format::urn, String>();
+    String s6 = a.to_string<upper_hex32, String>();
+    String s7 = a.to_string<upper_urn, String>();
+
+    runtime_assert(s1 == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_string_format() #2");
+    runtime_assert(s2 == S("D604557F-6739-4883-B627-BC0A81B84E97"), "test_string_format() #3");
+    runtime_assert(s3 == S("d604557f67394883b627bc0a81b84e97"), "test_string_format() #4");
+    runtime_assert(s4 == S("{d604557f-6739-4883-b627-bc0a81b84e97}"), "test_string_format() #5");
+    runtime_assert(s5 == S("urn:uuid:d604557f-6739-4883-b627-bc0a81b84e97"), "test_string_format() #6");
+    runtime_assert(s6 == S("D604557F67394883B627BC0A81B84E97"), "test_string_format() #7");
+    runtime_assert(s7 == S("urn:uuid:D604557F-6739-4883-B627-BC0A81B84E97"), "test_string_format() #8");
+    runtime_assert(String(s_array.data()) == S("{D604557F-6739-4883-B627-BC0A81B84E97}"), "test_string_format() #9");
+
+    static_assert(format::urn::length == 45, "test_string_format() #10");
+    static_assert(upper_hex32::length == 32, "test_string_format() #11");
+}
+
+static void test_parse_urn()
+{
+    constexpr auto a = uuid{S("urn:uuid:d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid{S("URN:UUID:D604557F-6739-4883-B627-BC0A81B84E97")};
+    constexpr auto c = uuid{S("urn:uuid:d604557f67394883b627bc0a81b84e97")};
+    constexpr auto d = uuid::parse<format::urn>(S("urn:uuid:d604557f-6739-4883-b627-bc0a81b84e97"));
+    constexpr auto e = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    static_assert(a == e, "test_parse_urn() #1");
+    static_assert(b == e, "test_parse_urn() #2");
+    static_assert(c == e, "test_parse_urn() #3");
+    static_assert(d == e, "test_parse_urn() #4");
+
+    try {
+        uuid{S("urn:uuid:{d604557f-6739-4883-b627-bc0a81b84e97}")};
+        runtime_assert(0, "test_parse_urn() #5");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid{S("urn:uid:d604557f-6739-4883-b627-bc0a81b84e97")};
+        runtime_assert(0, "test_parse_urn() #6");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_istream()
+{
+#if !HAVE_UNICODE || CHAR_TYPE == CT_WCHAR_T
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+
+    std::basic_istringstream<CharT> iss {
+        S("  d604557f-6739-4883-b627-bc0a81b84e97\n01926c01-ba2c-7315-a16a-0e16d8a51d4c x")
+    };
+    uuid c, d, e;
+    iss >> c >> d;
+
+    runtime_assert(iss.good(), "test_istream() #1");
+    runtime_assert(c == a, "test_istream() #2");
+    runtime_assert(d == b, "test_istream() #3");
+
+    iss >> e;
+    runtime_assert(iss.fail(), "test_istream() #4");
+    runtime_assert(e.is_nil(), "test_istream() #5");
+
+    std::basic_istringstream<CharT> bad { S("d604557f-6739-4883-b627=bc0a81b84e97") };
+    bad >> e;
+    runtime_assert(bad.fail(), "test_istream() #6");
+#endif
+}
+
+static void test_formatter()
+{
+#if defined(__cpp_lib_format) && (!HAVE_UNICODE || CHAR_TYPE == CT_WCHAR_T)
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    String s1 = std::format(S("{}"), a);
+    String s2 = std::format(S("{:Xb}"), a);
+    String s3 = std::format(S("[{:n}]"), a);
+    String s4 = std::format(S("{:u}"), a);
+
+    runtime_assert(s1 == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_formatter() #1");
+    runtime_assert(s2 == S("{D604557F-6739-4883-B627-BC0A81B84E97}"), "test_formatter() #2");
+    runtime_assert(s3 == S("[d604557f67394883b627bc0a81b84e97]"), "test_formatter() #3");
+    runtime_assert(s4 == S("urn:uuid:d604557f-6739-4883-b627-bc0a81b84e97"), "test_formatter() #4");
+#endif
+}
+
+static void test_base64url()
+{
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid::parse<format::base64url>(S("1gRVf2c5SIO2J7wKgbhOlw"));
+    constexpr auto c = uuid::parse<format::base64url>(S("AAAAAAAAAAAAAAAAAAAAAA"));
+    constexpr auto d = uuid::parse<format::base64url>(S("_____________________w"));
+
+    constexpr auto s_array = [&] {
+        std::array<CharT, 23> buf;
+        auto wrote = a.write_string<format::base64url>(buf);
+        runtime_assert(wrote == 23, "test_base64url() #1");
+        return buf;
+    }();
+    String s1 = a.to_string<format::base64url, String>();
+    String s2 = d.to_string<format::base64url, String>();
+    auto e = uuid::parse<format::base64url>(s1);
+
+    static_assert(a == b, "test_base64url() #2");
+    static_assert(c.is_nil(), "test_base64url() #3");
+    static_assert(d == uuid{S("ffffffff-ffff-ffff-ffff-ffffffffffff")}, "test_base64url() #4");
+    runtime_assert(String(s_array.data()) == S("1gRVf2c5SIO2J7wKgbhOlw"), "test_base64url() #5");
+    runtime_assert(s1 == S("1gRVf2c5SIO2J7wKgbhOlw"), "test_base64url() #6");
+    runtime_assert(s2 == S("_____________________w"), "test_base64url() #7");
+    runtime_assert(a == e, "test_base64url() #8");
+}
+
+static void test_base32()
+{
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto b = uuid{S("01926c01-ba2d-708e-90a1-cc63e523be32")};
+    constexpr auto c = uuid::parse<format::base32>(S("01J9P03EHCECAT2TGE2VCAA7AC"));
+    constexpr auto d = uuid::parse<format::base32>(S("01j9p03ehcecat2tge2vcaa7ac"));
+    constexpr auto e = uuid::parse<format::base32>(S("7ZZZZZZZZZZZZZZZZZZZZZZZZZ"));
+    constexpr auto f = uuid::parse<format::base32>(S("OIJ9P03EHCECAT2TGE2VCAA7AC"));
+
+    String s1 = a.to_string<format::base32, String>();
+    String s2 = b.to_string<format::base32, String>();
+    String s3 = e.to_string<format::base32, String>();
+
+    static_assert(a == c, "test_base32() #1");
+    static_assert(a == d, "test_base32() #2");
+    static_assert(a == f, "test_base32() #3");
+    static_assert(e == uuid{S("ffffffff-ffff-ffff-ffff-ffffffffffff")}, "test_base32() #4");
+    runtime_assert(s1 == S("01J9P03EHCECAT2TGE2VCAA7AC"), "test_base32() #5");
+    runtime_assert(s3 == S("7ZZZZZZZZZZZZZZZZZZZZZZZZZ"), "test_base32() #6");
+    runtime_assert(a < b && s1 < s2, "test_base32() #7");
+    runtime_assert(uuid::parse<format::base32>(s2) == b, "test_base32() #8");
+}
+
+static void test_base58()
+{
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid::parse<format::base58>(S("TRors8vArqFHC51KAhNsfC"));
+    constexpr auto c = uuid::parse<format::base58>(S("1111111111111111111111"));
+    constexpr auto d = uuid::parse<format::base58>(S("YcVfxkQb6JRzqk5kF2tNLv"));
+
+    String s1 = a.to_string<format::base58, String>();
+    String s2 = d.to_string<format::base58, String>();
+    String s3 = c.to_string<format::base58, String>();
+
+    static_assert(a == b, "test_base58() #1");
+    static_assert(c.is_nil(), "test_base58() #2");
+    static_assert(d == uuid{S("ffffffff-ffff-ffff-ffff-ffffffffffff")}, "test_base58() #3");
+    runtime_assert(s1 == S("TRors8vArqFHC51KAhNsfC"), "test_base58() #4");
+    runtime_assert(s2 == S("YcVfxkQb6JRzqk5kF2tNLv"), "test_base58() #5");
+    runtime_assert(s3 == S("1111111111111111111111"), "test_base58() #6");
+}
+
+static void test_encoding_error()
+{
+    try {
+        uuid::parse<format::base64url>(S("1gRVf2c5SIO2J7wKgbhOl"));
+        runtime_assert(0, "test_encoding_error() #1");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base64url>(S("1gRVf2c5SIO2J7wKgbhO+w"));
+        runtime_assert(0, "test_encoding_error() #2");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base64url>(S("1gRVf2c5SIO2J7wKgbhOlx"));
+        runtime_assert(0, "test_encoding_error() #3");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base32>(S("81J9P03EHCECAT2TGE2VCAA7AC"));
+        runtime_assert(0, "test_encoding_error() #4");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base32>(S("01J9P03EHCECAT2TGE2VCAA7AU"));
+        runtime_assert(0, "test_encoding_error() #5");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base58>(S("zzzzzzzzzzzzzzzzzzzzzz"));
+        runtime_assert(0, "test_encoding_error() #6");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        uuid::parse<format::base58>(S("TRors8vArqFHC51KAhNsf0"));
+        runtime_assert(0, "test_encoding_error() #7");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+        std::array<CharT, 22> buf;
+        a.write_string<format::base64url>(buf);
+        runtime_assert(0, "test_encoding_error() #8");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_scanner()
+{
+    constexpr auto a = uuid{"d604557f-6739-4883-b627-bc0a81b84e97"};
+    constexpr auto b = uuid{"01926c01-ba2c-7315-a16a-0e16d8a51d4c"};
+
+    std::string text =
+        "id=d604557f-6739-4883-b627-bc0a81b84e97 "  // 3
+        "f01926c01-ba2c-7315-a16a-0e16d8a51d4c "    // hex boundary
+        "{01926C01-BA2C-7315-A16A-0E16D8A51D4C}, "  // 78
+        "d604557f67394883b627bc0a81b84e97 "         // 118
+        "d604557f-6739-4883-b627-bc0a81b84e9g "     // invalid hex
+        "01926c01-ba2c-7315-a16a-0e16d8a51d4c";     // 188
+
+    std::vector<uuid_match> v1;
+    scan_uuids(text, [&](const uuid_match& m) { v1.push_back(m); });
+
+    std::vector<uuid_match> v2;
+    scan_uuids(text, [&](const uuid_match& m) { v2.push_back(m); },
+               scan_mode::hex32 | scan_mode::braced);
+
+    std::array<uuid_match, 2> out;
+    auto count = scan_uuids(text, out);
+
+    runtime_assert(v1.size() == 3, "test_scanner() #1");
+    runtime_assert(v1[0].offset == 3 && v1[0].length == 36 && v1[0].value == a, "test_scanner() #2");
+    runtime_assert(v1[1].offset == 79 && v1[1].length == 36 && v1[1].value == b, "test_scanner() #3");
+    runtime_assert(v1[2].offset == 188 && v1[2].value == b, "test_scanner() #4");
+
+    runtime_assert(v2.size() == 4, "test_scanner() #5");
+    runtime_assert(v2[1].offset == 78 && v2[1].length == 38, "test_scanner() #6");
+    runtime_assert(v2[2].offset == 118 && v2[2].length == 32 && v2[2].value == a, "test_scanner() #7");
+
+    runtime_assert(count == 2, "test_scanner() #8");
+    runtime_assert(out[1].offset == 79, "test_scanner() #9");
+}
+
+static void test_stream_scanner()
+{
+    constexpr auto a = uuid{"d604557f-6739-4883-b627-bc0a81b84e97"};
+
+    std::string text =
+        "id=d604557f-6739-4883-b627-bc0a81b84e97 "
+        "f01926c01-ba2c-7315-a16a-0e16d8a51d4c "
+        "{01926C01-BA2C-7315-A16A-0E16D8A51D4C}{d604557f-6739-4883-b627-bc0a81b84e97}"
+        "d604557f67394883b627bc0a81b84e97 "
+        "d604557f-6739-4883-b627-bc0a81b84e9g "
+        "d604557f67394883b627bc0a81b84e97-01926c01-ba2c-7315-a16a-0e16d8a51d4c\n";
+    std::mt19937_64 mt;
+    for (int i = 0; i < 50; i++)
+        text += text.substr(mt() % 200, mt() % 100);
+    text += "01926c01-ba2c-7315-a16a-0e16d8a51d4c";
+
+    auto same = [](const std::vector<uuid_match>& x, const std::vector<uuid_match>& y) {
+        return std::equal(x.begin(), x.end(), y.begin(), y.end(), [](const uuid_match& l, const uuid_match& r) {
+            return l.offset == r.offset && l.length == r.length && l.value == r.value;
+        });
+    };
+
+    bool all = true;
+    for (auto mode : { scan_mode::standard, scan_mode::hex32, scan_mode::braced, scan_mode::hex32 | scan_mode::braced }) {
+        std::vector<uuid_match> expected;
+        scan_uuids(text, [&](const uuid_match& m) { expected.push_back(m); }, mode);
+
+        uuid_stream_scanner scanner(mode);
+        for (size_t chunk : { 1, 2, 3, 7, 36, 37, 38, 39, 64, 100, 100'000, 0 }) {
+            std::vector<uuid_match> found;
+            auto push = [&](const uuid_match& m) { found.push_back(m); };
+            for (size_t i = 0; i < text.size();) {
+                auto n = std::min(chunk != 0 ? chunk : 1 + mt() % 80, text.size() - i);
+                scanner.feed(std::span<const char>(text).subspan(i, n), push);
+                i += n;
+            }
+            all = all && scanner.position() == text.size();
+            scanner.finish(push);
+            all = all && same(found, expected) && scanner.position() == 0;
+        }
+    }
+    runtime_assert(all, "test_stream_scanner() #1");
+
+    // scatter-gather
+    std::vector<uuid_match> expected, found;
+    scan_uuids(text, [&](const uuid_match& m) { expected.push_back(m); });
+    uuid_stream_scanner scanner;
+    std::vector<std::span<const char>> pieces;
+    for (size_t i = 0; i < text.size(); i += 50)
+        pieces.push_back(std::span<const char>(text).subspan(i, std::min<size_t>(50, text.size() - i)));
+    scanner.feed(pieces, [&](const uuid_match& m) { found.push_back(m); });
+    scanner.finish([&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(same(found, expected), "test_stream_scanner() #2");
+
+#ifndef _WIN32
+    std::vector<iovec> iov;
+    for (auto& p : pieces)
+        iov.push_back({ const_cast<char*>(p.data()), p.size() });
+    found.clear();
+    scanner.feed(iov, [&](const uuid_match& m) { found.push_back(m); });
+    scanner.finish([&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(same(found, expected), "test_stream_scanner() #3");
+#endif
+
+    // a match at the end of the stream waits for finish, reset drops it
+    found.clear();
+    std::string_view last = "x d604557f-6739-4883-b627-bc0a81b84e97";
+    scanner.feed(last.substr(0, 20), [&](const uuid_match& m) { found.push_back(m); });
+    scanner.feed(last.substr(20), [&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(found.empty(), "test_stream_scanner() #4");
+    scanner.finish([&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(found.size() == 1 && found[0].offset == 2 && found[0].value == a, "test_stream_scanner() #5");
+    scanner.feed(last, [&](const uuid_match& m) { found.push_back(m); });
+    scanner.reset();
+    scanner.finish([&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(found.size() == 1, "test_stream_scanner() #6");
+
+    // a callback returning false stops the piece, which is still consumed; what it skipped stays skipped
+    found.clear();
+    auto first_only = [&](const uuid_match& m) { found.push_back(m); return false; };
+    std::string_view stop = "x d604557f-6739-4883-b627-bc0a81b84e97 y d604557f-6739-4883-b627-bc0a81b84e97 z ";
+    bool fed = scanner.feed(stop.substr(0, 15), first_only) && scanner.feed(stop.substr(15), first_only);
+    runtime_assert(!fed && found.size() == 1 && found[0].offset == 2 && scanner.position() == stop.size(), "test_stream_scanner() #7");
+    fed = scanner.feed(last, [&](const uuid_match& m) { found.push_back(m); }) &&
+          scanner.finish([&](const uuid_match& m) { found.push_back(m); });
+    runtime_assert(fed && found.size() == 2 && found[1].offset == stop.size() + 2, "test_stream_scanner() #8");
+}
+
 static void test_bytelike()
 {
     enum class enum_uchar : unsigned char { zero = 0 };
@@ -434,6 +863,51 @@ static void test_binary()
     test_binary_impl<uint8_t>();
 }
 
+template <class ByteT>
+void test_guid_binary_impl()
+{
+    constexpr auto a = uuid{S("00112233-4455-6677-8899-aabbccddeeff")};
+
+    constexpr std::array<ByteT, 16> bytes_a {
+        ByteT(0x33), ByteT(0x22), ByteT(0x11), ByteT(0x00),
+        ByteT(0x55), ByteT(0x44), ByteT(0x77), ByteT(0x66),
+        ByteT(0x88), ByteT(0x99), ByteT(0xaa), ByteT(0xbb),
+        ByteT(0xcc), ByteT(0xdd), ByteT(0xee), ByteT(0xff),
+    };
+
+    constexpr auto b = uuid::from_bytes<layout::guid>(std::span<const ByteT>(bytes_a));
+
+    constexpr auto bytes_b = [&] {
+        std::array<ByteT, 16> bytes;
+        auto wrote = a.write_bytes<layout::guid>(bytes);
+        runtime_assert(wrote == 16, "test_guid_binary_impl() #1");
+        return bytes;
+    }();
+
+    constexpr auto bytes_c = a.to_bytes<layout::guid, ByteT>();
+    constexpr auto bytes_d = a.to_bytes<layout::big_endian, ByteT>();
+    constexpr auto c = uuid::from_bytes<layout::big_endian>(std::span<const ByteT>(bytes_d));
+
+    static_assert(a == b, "test_guid_binary_impl() #2");
+    static_assert(bytes_a == bytes_b, "test_guid_binary_impl() #3");
+    static_assert(bytes_a == bytes_c, "test_guid_binary_impl() #4");
+    static_assert(bytes_d == a.to_bytes<ByteT>(), "test_guid_binary_impl() #5");
+    static_assert(a == c, "test_guid_binary_impl() #6");
+
+    try {
+        std::array<ByteT, 15> bytes;
+        a.write_bytes<layout::guid>(bytes);
+        runtime_assert(0, "test_guid_binary_impl() #7");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_guid_binary()
+{
+    test_guid_binary_impl<std::byte>();
+    test_guid_binary_impl<uint8_t>();
+}
+
 template <class ByteT>
 void test_binary_error_impl()
 {
@@ -466,6 +940,148 @@ static void test_binary_error()
     test_binary_error_impl<uint8_t>();
 }
 
+static void test_view()
+{
+    static constexpr std::array<std::byte, 48> records {
+        std::byte(0x01), std::byte(0x92), std::byte(0x6c), std::byte(0x01),
+        std::byte(0xba), std::byte(0x2c), std::byte(0x73), std::byte(0x15),
+        std::byte(0xa1), std::byte(0x6a), std::byte(0x0e), std::byte(0x16),
+        std::byte(0xd8), std::byte(0xa5), std::byte(0x1d), std::byte(0x4c),
+
+        std::byte(0xd6), std::byte(0x04), std::byte(0x55), std::byte(0x7f),
+        std::byte(0x67), std::byte(0x39), std::byte(0x48), std::byte(0x83),
+        std::byte(0xb6), std::byte(0x27), std::byte(0xbc), std::byte(0x0a),
+        std::byte(0x81), std::byte(0xb8), std::byte(0x4e), std::byte(0x97),
+    };
+
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto b = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    constexpr auto va = uuid_view::at(records, 0);
+    constexpr auto vb = uuid_view::at(records, 1);
+    constexpr auto vn = uuid_view::at(records, 2);
+
+    static_assert(va.to_uuid() == a, "test_view() #1");
+    static_assert(uuid(vb) == b, "test_view() #2");
+    static_assert(va == a && vb == b && va != b, "test_view() #3");
+    static_assert(va < vb && vb > va && va == va, "test_view() #4");
+    static_assert((vb <=> a) > 0, "test_view() #5");
+    static_assert(va.get_version() == 7 && vb.get_version() == 4, "test_view() #6");
+    static_assert(va.get_variant() == 2 && vb.get_variant() == 2, "test_view() #7");
+    static_assert(vn.is_nil() && !va.is_nil(), "test_view() #8");
+    static_assert(vb.to_chars<format::standard, CharT>() == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_view() #9");
+    static_assert(vb.bytes().data() == records.data() + 16, "test_view() #10");
+
+    // run time comparison uses memcmp, which must agree with uuid ordering
+    runtime_assert(va < vb && (va <=> vb) == (a <=> b), "test_view() #11");
+    runtime_assert(va == uuid_view(std::span(records).first<16>()), "test_view() #12");
+    runtime_assert(va.hash() == a.hash(), "test_view() #13");
+    runtime_assert(std::hash<uuid_view>{}(vb) == std::hash<uuid>{}(b), "test_view() #14");
+
+    String s = vb.to_string<String>();
+    runtime_assert(s == S("d604557f-6739-4883-b627-bc0a81b84e97"), "test_view() #15");
+
+    std::array<CharT, 37> buf;
+    runtime_assert(va.write_string(buf) == 37, "test_view() #16");
+    runtime_assert(String(buf.data()) == S("01926c01-ba2c-7315-a16a-0e16d8a51d4c"), "test_view() #17");
+
+    auto u8 = a.to_bytes<uint8_t>();
+    runtime_assert(uuid_view(u8) == va, "test_view() #18");
+
+    try {
+        uuid_view::at(std::span(records).first(47), 2);
+        runtime_assert(0, "test_view() #19");
+    }
+    catch (std::out_of_range&) {}
+}
+
+template <class ByteT>
+void test_bulk_binary_impl(size_t count)
+{
+    std::vector<uuid> in;
+    uuid_random rng;
+    for (size_t i = 0; i < count; i++)
+        in.push_back(uuid_generator_v4::generate(rng));
+
+    std::vector<ByteT> bytes(count * 16);
+    auto wrote = store_many(in, bytes);
+
+    std::vector<ByteT> expected;
+    for (auto& u : in) {
+        auto a = u.to_bytes<ByteT>();
+        expected.insert(expected.end(), a.begin(), a.end());
+    }
+
+    std::vector<uuid> out(count);
+    auto loaded = load_many(bytes, out);
+
+    runtime_assert(wrote == count * 16, "test_bulk_binary_impl() #1");
+    runtime_assert(bytes == expected, "test_bulk_binary_impl() #2");
+    runtime_assert(loaded == count, "test_bulk_binary_impl() #3");
+    runtime_assert(out == in, "test_bulk_binary_impl() #4");
+
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto c = [&] {
+        std::array<uuid, 2> src { a, b };
+        std::array<ByteT, 32> buf;
+        store_many(src, buf);
+        std::array<uuid, 2> dst;
+        load_many(buf, dst);
+        return dst;
+    }();
+    static_assert(c[0] == a && c[1] == b, "test_bulk_binary_impl() #5");
+
+    // heap buffers: GCC warns about the SIMD path on an undersized std::array it cannot prove unreachable
+    try {
+        std::vector<ByteT> buf(31);
+        store_many(std::span(in).first(2), buf);
+        runtime_assert(0, "test_bulk_binary_impl() #6");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        std::vector<ByteT> buf(31);
+        load_many(buf, std::span(out).first(2));
+        runtime_assert(0, "test_bulk_binary_impl() #7");
+    }
+    catch (std::invalid_argument&) {}
+
+    std::vector<ByteT> guid_bytes(count * 16);
+    wrote = store_many<layout::guid>(in, guid_bytes);
+
+    expected.clear();
+    for (auto& u : in) {
+        auto g = u.to_bytes<layout::guid, ByteT>();
+        expected.insert(expected.end(), g.begin(), g.end());
+    }
+
+    std::vector<uuid> guid_out(count);
+    loaded = load_many<layout::guid>(guid_bytes, guid_out);
+
+    runtime_assert(wrote == count * 16, "test_bulk_binary_impl() #8");
+    runtime_assert(guid_bytes == expected, "test_bulk_binary_impl() #9");
+    runtime_assert(loaded == count, "test_bulk_binary_impl() #10");
+    runtime_assert(guid_out == in, "test_bulk_binary_impl() #11");
+
+    constexpr auto d = [&] {
+        std::array<uuid, 2> src { a, b };
+        std::array<ByteT, 32> buf;
+        store_many<layout::guid>(src, buf);
+        std::array<uuid, 2> dst;
+        load_many<layout::guid>(buf, dst);
+        return dst;
+    }();
+    static_assert(d[0] == a && d[1] == b, "test_bulk_binary_impl() #12");
+}
+
+static void test_bulk_binary()
+{
+    test_bulk_binary_impl<std::byte>(37);
+    test_bulk_binary_impl<uint8_t>(37);
+    test_bulk_binary_impl<std::byte>(300'000); // non-temporal stores
+}
+
 template <class Map>
 static void test_map_impl()
 {
@@ -496,6 +1112,1288 @@ static void test_map()
 {
     test_map_impl<std::map<uuid, String>>();
     test_map_impl<std::unordered_map<uuid, String>>();
+    test_map_impl<std::unordered_map<uuid, String, uuid_seeded_hash>>();
+    test_map_impl<std::unordered_map<uuid, String, uuid_trusted_v4_hash>>();
+    test_map_impl<uuid_flat_map<String>>();
+}
+
+static void test_flat_set()
+{
+    uuid_flat_set set;
+    std::vector<uuid> keys;
+    uuid_random rng;
+    for (int i = 0; i < 10'000; i++)
+        keys.push_back(uuid_generator_v4::generate(rng));
+
+    for (auto& k : keys)
+        runtime_assert(set.insert(k).second, "test_flat_set() #1");
+    runtime_assert(set.size() == keys.size(), "test_flat_set() #2");
+    runtime_assert(!set.insert(keys[0]).second, "test_flat_set() #3");
+
+    for (auto& k : keys)
+        runtime_assert(set.contains(k), "test_flat_set() #4");
+    runtime_assert(!set.contains(uuid_generator_v4::generate(rng)), "test_flat_set() #5");
+
+    // nil is an ordinary key, not the empty marker
+    runtime_assert(!set.contains(uuid{}), "test_flat_set() #6");
+    runtime_assert(set.insert(uuid{}).second, "test_flat_set() #7");
+    runtime_assert(set.contains(uuid{}), "test_flat_set() #8");
+
+    size_t n = 0;
+    for (auto& k : set) {
+        (void)k;
+        n++;
+    }
+    runtime_assert(n == set.size(), "test_flat_set() #9");
+
+    // erase half, the rest must stay reachable through the tombstones
+    for (size_t i = 0; i < keys.size(); i += 2)
+        runtime_assert(set.erase(keys[i]) == 1, "test_flat_set() #10");
+    runtime_assert(set.erase(keys[0]) == 0, "test_flat_set() #11");
+    runtime_assert(set.size() == keys.size() / 2 + 1, "test_flat_set() #12");
+    for (size_t i = 0; i < keys.size(); i++)
+        runtime_assert(set.contains(keys[i]) == (i % 2 == 1), "test_flat_set() #13");
+
+    // reinsert through tombstones, then batch lookup
+    for (size_t i = 0; i < keys.size(); i += 2)
+        set.insert(keys[i]);
+    keys.push_back(uuid_generator_v4::generate(rng));
+    auto found_buf = std::make_unique<bool[]>(keys.size());
+    std::span<bool> found(found_buf.get(), keys.size());
+    runtime_assert(set.find_many(keys, found) == keys.size() - 1, "test_flat_set() #14");
+    runtime_assert(found.front() && !found.back(), "test_flat_set() #15");
+
+    auto copy = set;
+    set.clear();
+    runtime_assert(set.empty() && !set.contains(keys[1]), "test_flat_set() #16");
+    runtime_assert(copy.size() == keys.size() && copy.contains(keys[1]), "test_flat_set() #17");
+
+    uuid_basic_flat_set<uuid_trusted_v4_hash> trusted { keys[0], keys[1], keys[0] };
+    runtime_assert(trusted.size() == 2 && trusted.contains(keys[1]), "test_flat_set() #18");
+}
+
+// copying throws once budget reaches 0; the move may throw, so a rehash copies
+struct throwing_copy
+{
+    static inline int budget = -1;
+    int value;
+
+    explicit throwing_copy(int v) : value(v) {}
+    throwing_copy(const throwing_copy& r) : value(r.value) {
+        if (budget == 0)
+            throw std::runtime_error("throwing_copy");
+        budget--;
+    }
+    throwing_copy(throwing_copy&& r) : value(r.value) {}
+};
+
+static void test_flat_map()
+{
+    uuid_flat_map<String> map;
+    std::vector<uuid> keys;
+    uuid_random rng;
+    for (int i = 0; i < 1'000; i++)
+        keys.push_back(uuid_generator_v7::generate(rng));
+
+    for (size_t i = 0; i < keys.size(); i++)
+        map[keys[i]] = String(i % 7 + 1, S('x'));
+    runtime_assert(map.size() == keys.size(), "test_flat_map() #1");
+    runtime_assert(map.at(keys[3]) == S("xxxx"), "test_flat_map() #2");
+
+    auto [it, inserted] = map.try_emplace(keys[3], S("y"));
+    runtime_assert(!inserted && it->second == S("xxxx"), "test_flat_map() #3");
+    runtime_assert(map.find(uuid{}) == map.end(), "test_flat_map() #4");
+
+    std::vector<String*> out(keys.size() + 1);
+    auto lookup = keys;
+    lookup.push_back(uuid{});
+    runtime_assert(map.find_many(lookup, std::span(out)) == keys.size(), "test_flat_map() #5");
+    runtime_assert(*out[7] == S("x") && out.back() == nullptr, "test_flat_map() #6");
+
+    for (auto& [k, v] : map)
+        v += S("!");
+    runtime_assert(map.at(keys[0]) == S("x!"), "test_flat_map() #7");
+
+    map.erase(keys[0]);
+    try {
+        map.at(keys[0]);
+        runtime_assert(0, "test_flat_map() #8");
+    }
+    catch (std::out_of_range&) {}
+
+    const auto& cmap = map;
+    std::vector<const String*> cout(2);
+    std::array<uuid, 2> two { keys[0], keys[1] };
+    runtime_assert(cmap.find_many(two, std::span(cout)) == 1 && cout[0] == nullptr, "test_flat_map() #9");
+
+    auto moved = std::move(map);
+    runtime_assert(moved.size() == keys.size() - 1 && map.empty(), "test_flat_map() #10");
+
+    // a rehash that throws halfway leaves the table as it was
+    uuid_flat_map<throwing_copy> fragile;
+    for (int i = 0; i < 14; i++)
+        fragile.try_emplace(keys[i], i);
+    auto capacity = fragile.capacity();
+    throwing_copy::budget = 3;
+    try {
+        fragile.try_emplace(keys[14], 14);
+        runtime_assert(0, "test_flat_map() #11");
+    }
+    catch (std::runtime_error&) {}
+    throwing_copy::budget = -1;
+    bool intact = fragile.size() == 14 && fragile.capacity() == capacity && !fragile.contains(keys[14]);
+    for (int i = 0; i < 14; i++)
+        intact = intact && fragile.at(keys[i]).value == i;
+    runtime_assert(intact, "test_flat_map() #12");
+    fragile.try_emplace(keys[14], 14);
+    runtime_assert(fragile.size() == 15 && fragile.at(keys[14]).value == 14 && fragile.at(keys[3]).value == 3, "test_flat_map() #13");
+}
+
+static void test_concurrent_map()
+{
+    uuid_concurrent_map<String> map(5);
+    runtime_assert(map.shard_count() == 8, "test_concurrent_map() #1");
+
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto b = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    runtime_assert(map.try_emplace(a, S("a")), "test_concurrent_map() #2");
+    runtime_assert(!map.try_emplace(a, S("x")), "test_concurrent_map() #3");
+    runtime_assert(map.find(a) == S("a"), "test_concurrent_map() #4");
+    runtime_assert(!map.find(b).has_value(), "test_concurrent_map() #5");
+
+    runtime_assert(map.insert_or_assign(b, S("b")), "test_concurrent_map() #6");
+    runtime_assert(!map.insert_or_assign(b, S("bb")), "test_concurrent_map() #7");
+    runtime_assert(map.update(b, [](String& v) { v += S("!"); }), "test_concurrent_map() #8");
+
+    String seen;
+    runtime_assert(map.visit(b, [&](const String& v) { seen = v; }), "test_concurrent_map() #9");
+    runtime_assert(seen == S("bb!"), "test_concurrent_map() #10");
+    runtime_assert(map.size() == 2 && map.contains(a), "test_concurrent_map() #11");
+
+    runtime_assert(map.erase(a) && !map.erase(a), "test_concurrent_map() #12");
+    runtime_assert(map.size() == 1, "test_concurrent_map() #13");
+
+    // disjoint writers and concurrent readers
+    uuid_concurrent_map<int> shared;
+    constexpr int threads = 4;
+    constexpr int per_thread = 5'000;
+    std::vector<std::vector<uuid>> keys(threads);
+    uuid_random rng;
+    for (auto& k : keys) {
+        for (int i = 0; i < per_thread; i++)
+            k.push_back(uuid_generator_v4::generate(rng));
+    }
+
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; i++) {
+                    shared.try_emplace(keys[t][i], i);
+                    shared.contains(keys[(t + 1) % threads][i]);
+                }
+            });
+        }
+    }
+
+    runtime_assert(shared.size() == threads * per_thread, "test_concurrent_map() #14");
+    runtime_assert(shared.find(keys[2][1234]) == 1234, "test_concurrent_map() #15");
+
+    size_t total = 0;
+    shared.for_each([&](const uuid&, int v) { total += v; });
+    runtime_assert(total == size_t(threads) * per_thread * (per_thread - 1) / 2, "test_concurrent_map() #16");
+
+    shared.clear();
+    runtime_assert(shared.size() == 0, "test_concurrent_map() #17");
+}
+
+static void test_dictionary()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 10'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+
+    uuid_dictionary dict;
+    for (size_t i = 0; i < keys.size(); i++)
+        runtime_assert(dict.intern(keys[i]) == i, "test_dictionary() #1");
+    runtime_assert(dict.intern(keys[123]) == 123 && dict.size() == keys.size(), "test_dictionary() #2");
+    runtime_assert(dict.find(keys[77]) == 77u && !dict.find(uuid{}).has_value(), "test_dictionary() #3");
+    runtime_assert(dict[42] == keys[42] && dict.at(9'999) == keys[9'999], "test_dictionary() #4");
+    runtime_assert(std::ranges::equal(dict.uuids(), keys), "test_dictionary() #5");
+
+    try {
+        (void)dict.at(10'000);
+        runtime_assert(0, "test_dictionary() #6");
+    }
+    catch (std::out_of_range&) {}
+
+    // half known, half new, new keys repeated within the batch
+    std::vector<uuid> batch;
+    for (int i = 0; i < 600; i++)
+        batch.push_back(i % 2 ? keys[i] : uuid_generator_v4::generate(mt));
+    for (int i = 0; i < 100; i++)
+        batch.push_back(batch[i]);
+    std::vector<uint32_t> ids(batch.size());
+    runtime_assert(dict.intern_many(batch, ids) == 300, "test_dictionary() #7");
+    runtime_assert(dict.size() == keys.size() + 300, "test_dictionary() #8");
+    for (size_t i = 0; i < batch.size(); i++)
+        runtime_assert(dict[ids[i]] == batch[i], "test_dictionary() #9");
+    runtime_assert(ids[1] == 1 && ids[0] == 10'000 && ids[600] == ids[0], "test_dictionary() #10");
+
+    std::vector<uuid> resolved(batch.size());
+    dict.resolve_many(ids, resolved);
+    runtime_assert(resolved == batch, "test_dictionary() #11");
+
+    std::vector<uuid> lookup = { keys[5], uuid{}, batch[2] };
+    std::vector<uint32_t> found(lookup.size());
+    runtime_assert(dict.find_many(lookup, found) == 2, "test_dictionary() #12");
+    runtime_assert(found[0] == 5 && found[1] == uuid_dictionary::npos && found[2] == ids[2], "test_dictionary() #13");
+
+    dict.clear();
+    runtime_assert(dict.empty() && dict.intern(keys[1]) == 0, "test_dictionary() #14");
+
+    uuid_dictionary64 dict64;
+    static_assert(std::is_same_v<decltype(dict64.intern(keys[0])), uint64_t>, "test_dictionary() #15");
+
+    // concurrent: threads intern overlapping keys, every key ends up with exactly one id
+    uuid_concurrent_dictionary shared(4);
+    constexpr int threads = 4;
+    std::vector<std::vector<uint32_t>> out(threads, std::vector<uint32_t>(keys.size()));
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&, t] {
+                auto& o = out[t];
+                for (size_t i = 0; i < keys.size(); i++) {
+                    auto j = (i + t * 2'500) % keys.size();
+                    o[j] = shared.intern(keys[j]);
+                    (void)shared[o[j]];
+                }
+            });
+        }
+    }
+    runtime_assert(shared.size() == keys.size(), "test_dictionary() #16");
+    std::vector<bool> seen(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        for (int t = 1; t < threads; t++)
+            runtime_assert(out[t][i] == out[0][i], "test_dictionary() #17");
+        runtime_assert(shared.at(out[0][i]) == keys[i] && !seen[out[0][i]], "test_dictionary() #18");
+        seen[out[0][i]] = true;
+    }
+
+    std::vector<uint32_t> again(batch.size());
+    runtime_assert(shared.intern_many(batch, again) == 300, "test_dictionary() #19");
+    runtime_assert(shared.find(batch[0]) == again[0] && shared.contains(keys[0]), "test_dictionary() #20");
+    shared.resolve_many(again, resolved);
+    runtime_assert(resolved == batch, "test_dictionary() #21");
+
+    // the map grows while a batch is interned: known keys after the new ones keep their ids
+    uuid_dictionary small;
+    std::vector<uuid> growing;
+    for (int i = 0; i < 14; i++)
+        small.intern(keys[i]);
+    for (int i = 0; i < 200; i++)
+        growing.push_back(uuid_generator_v4::generate(mt));
+    growing.insert(growing.end(), keys.begin(), keys.begin() + 14);
+    std::vector<uint32_t> grown(growing.size());
+    runtime_assert(small.intern_many(growing, grown) == 200, "test_dictionary() #22");
+    bool kept = true;
+    for (uint32_t i = 0; i < 14; i++)
+        kept = kept && grown[200 + i] == i;
+    for (size_t i = 0; i < 200; i++)
+        kept = kept && grown[i] == 14 + i && small[grown[i]] == growing[i];
+    runtime_assert(kept, "test_dictionary() #23");
+
+    // ids past size() throw, npos included
+    uuid_concurrent_dictionary64 shared64(1);
+    shared64.intern(keys[0]);
+    for (uint64_t id : { uint64_t{1}, uint64_t{1'000}, uuid_concurrent_dictionary64::npos }) {
+        try {
+            (void)shared64.at(id);
+            runtime_assert(0, "test_dictionary() #24");
+        }
+        catch (std::out_of_range&) {}
+    }
+}
+
+static void test_routing()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 100'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+    std::vector<uint32_t> out(keys.size()), more(keys.size());
+
+    auto balanced = [](std::span<const uint32_t> routes, size_t nodes) {
+        std::vector<size_t> count(nodes);
+        for (auto r : routes) {
+            if (r >= nodes)
+                return false;
+            count[r]++;
+        }
+        auto [lo, hi] = std::minmax_element(count.begin(), count.end());
+        auto average = routes.size() / nodes;
+        return *lo > average * 9 / 10 && *hi < average * 11 / 10;
+    };
+
+    // jump: batches match route(), growing moves keys only onto the new shard
+    uuid_jump_router jump10(10), jump11(11);
+    jump10.route_many(keys, out);
+    jump11.route_many(keys, more);
+    bool same = true, moved_right = true;
+    size_t moved = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+        same = same && out[i] == jump10.route(keys[i]) && more[i] == jump11.route(keys[i]);
+        moved_right = moved_right && (more[i] == out[i] || more[i] == 10);
+        moved += more[i] != out[i];
+    }
+    runtime_assert(same && moved_right, "test_routing() #1");
+    runtime_assert(balanced(out, 10) && moved > keys.size() / 11 * 9 / 10 && moved < keys.size() / 11 * 11 / 10, "test_routing() #2");
+    runtime_assert(uuid_jump_router(1).route(keys[0]) == 0 && uuid_jump_router::jump(0, 1) == 0, "test_routing() #3");
+    uuid_jump_router huge(3'000'000'000);
+    huge.route_many(std::span(keys).first(101), out);
+    same = true;
+    for (size_t i = 0; i < 101; i++)
+        same = same && out[i] == huge.route(keys[i]);
+    runtime_assert(same, "test_routing() #4");
+
+    // v7: only the random bits decide
+    uuid_v7_jump_router v7(16);
+    auto a = std::bit_cast<std::array<uint64_t, 2>>(uuid_generator_v7::generate(mt, 0x01926c01'ba2c));
+    auto later = a;
+    later[0] = (a[0] & 0xffff) | (uint64_t{0x01926c02'0000} << 16);
+    runtime_assert(v7.route(std::bit_cast<uuid>(a)) == v7.route(std::bit_cast<uuid>(later)), "test_routing() #5");
+    std::vector<uuid> same_ms;
+    for (int i = 0; i < 16'000; i++)
+        same_ms.push_back(uuid_generator_v7::generate(mt, 0x01926c01'ba2c));
+    v7.route_many(same_ms, out);
+    runtime_assert(balanced(std::span(out).first(same_ms.size()), 16), "test_routing() #6");
+
+    // rendezvous: removing a node moves only its keys
+    std::vector<uint64_t> ids { 10, 20, 30, 40, 50 }, fewer { 10, 20, 40, 50 };
+    uuid_rendezvous_router five(ids), four(fewer);
+    five.route_many(keys, out);
+    four.route_many(keys, more);
+    same = true;
+    bool kept = true;
+    for (size_t i = 0; i < keys.size(); i++) {
+        same = same && out[i] == five.route(keys[i]) && more[i] == four.route(keys[i]);
+        kept = kept && (ids[out[i]] == 30 || ids[out[i]] == fewer[more[i]]);
+    }
+    runtime_assert(same && kept && balanced(out, 5) && balanced(more, 4), "test_routing() #7");
+    uuid_rendezvous_router hundred(100);
+    hundred.route_many(keys, out);
+    runtime_assert(balanced(out, 100) && out[99'999] == hundred.route(keys[99'999]), "test_routing() #8");
+
+    // bounded-load ring
+    uuid_bounded_load_ring ring(20);
+    ring.route_many(keys, out);
+    same = true;
+    for (size_t i = 0; i < keys.size(); i++)
+        same = same && out[i] == ring.route(keys[i]);
+    runtime_assert(same && ring.total_load() == 0, "test_routing() #9");
+    auto sequential = ring;
+    ring.assign_many(keys, out);
+    same = true;
+    uint64_t max_load = 0;
+    for (size_t i = 0; i < keys.size(); i++)
+        same = same && out[i] == sequential.assign(keys[i]);
+    for (uint32_t n = 0; n < 20; n++)
+        max_load = std::max(max_load, ring.load(n));
+    runtime_assert(same && ring.total_load() == keys.size(), "test_routing() #10");
+    runtime_assert(max_load <= (keys.size() / 20) * 5 / 4, "test_routing() #11");
+    ring.release(out[0]);
+    runtime_assert(ring.total_load() == keys.size() - 1 && ring.load(out[0]) == sequential.load(out[0]) - 1, "test_routing() #12");
+    ring.clear_loads();
+    runtime_assert(ring.total_load() == 0 && ring.load(7) == 0, "test_routing() #13");
+
+    try {
+        ring.release(0);
+        runtime_assert(0, "test_routing() #14");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        uuid_jump_router(0);
+        runtime_assert(0, "test_routing() #15");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        uuid_bounded_load_ring(std::vector<uint64_t>{}, 16);
+        runtime_assert(0, "test_routing() #16");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        five.route_many(keys, std::span(out).first(10));
+        runtime_assert(0, "test_routing() #17");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_atomic_uuid()
+{
+    uuid_random rng;
+    auto a = uuid_generator_v4::generate(rng), b = uuid_generator_v7::generate(rng);
+
+    atomic_uuid nil, x(a);
+    runtime_assert(nil.load() == uuid{} && x.load(std::memory_order_acquire) == a && uuid(x) == a, "test_atomic_uuid() #1");
+#if defined(FQUUID_NO_SIMD)
+    runtime_assert(!x.is_lock_free(), "test_atomic_uuid() #2");
+#endif
+
+    x.store(b, std::memory_order_release);
+    runtime_assert(x.load() == b, "test_atomic_uuid() #3");
+    runtime_assert(x.exchange(a) == b && x.load() == a, "test_atomic_uuid() #4");
+    x = b;
+    runtime_assert(x.load() == b, "test_atomic_uuid() #5");
+
+    auto expected = a;
+    runtime_assert(!x.compare_exchange_strong(expected, a) && expected == b && x.load() == b, "test_atomic_uuid() #6");
+    runtime_assert(x.compare_exchange_strong(expected, a, std::memory_order_acq_rel, std::memory_order_acquire)
+        && expected == b && x.load() == a, "test_atomic_uuid() #7");
+    expected = a;
+    while (!x.compare_exchange_weak(expected, uuid{})) {}
+    runtime_assert(x.load() == uuid{}, "test_atomic_uuid() #8");
+
+    // counters in both halves: increments are not lost, reads are never torn
+    constexpr int threads = 4;
+    constexpr uint64_t per_thread = 20'000;
+    atomic_uuid counter;
+    std::atomic<bool> torn = false;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; t++) {
+            workers.emplace_back([&] {
+                auto cur = counter.load(std::memory_order_relaxed);
+                for (uint64_t i = 0; i < per_thread; i++) {
+                    auto w = std::bit_cast<std::array<uint64_t, 2>>(cur);
+                    if (w[0] != w[1])
+                        torn = true;
+                    auto next = std::bit_cast<uuid>(std::array<uint64_t, 2>{ w[0] + 1, w[1] + 1 });
+                    while (!counter.compare_exchange_weak(cur, next)) {
+                        w = std::bit_cast<std::array<uint64_t, 2>>(cur);
+                        next = std::bit_cast<uuid>(std::array<uint64_t, 2>{ w[0] + 1, w[1] + 1 });
+                    }
+                    cur = next;
+                    auto seen = std::bit_cast<std::array<uint64_t, 2>>(counter.load());
+                    if (seen[0] != seen[1])
+                        torn = true;
+                }
+            });
+        }
+        workers.emplace_back([&] {
+            for (uint64_t i = 0; i < per_thread; i++) {
+                auto w = std::bit_cast<std::array<uint64_t, 2>>(counter.load(std::memory_order_acquire));
+                if (w[0] != w[1])
+                    torn = true;
+            }
+        });
+    }
+    auto total = std::bit_cast<std::array<uint64_t, 2>>(counter.load());
+    runtime_assert(!torn && total[0] == threads * per_thread && total[1] == total[0], "test_atomic_uuid() #9");
+}
+
+static void test_sort()
+{
+    uuid_random rng;
+    std::mt19937_64 mt;
+
+    // random v4, v7 sharing a timestamp (uniform leading bytes) and duplicates
+    for (size_t n : { 0, 1, 100, 5'000, 300'000 }) {
+        std::vector<uuid> v4, v7;
+        auto base = uuid_generator_v7::generate(rng).to_bytes();
+        for (size_t i = 0; i < n; i++) {
+            v4.push_back(uuid_generator_v4::generate(mt));
+            auto b = base;
+            for (int k = 8; k < 16; k++)
+                b[k] = std::byte(mt() % 3); // few distinct values, many duplicates
+            v7.push_back(uuid{b});
+        }
+
+        for (auto* in : { &v4, &v7 }) {
+            auto expected = *in;
+            std::sort(expected.begin(), expected.end());
+
+            auto a = *in;
+            fquuid::sort(a);
+            runtime_assert(a == expected, "test_sort() #1");
+
+            auto b = *in;
+            std::vector<uuid> scratch(n);
+            fquuid::sort(b, scratch);
+            runtime_assert(b == expected, "test_sort() #2");
+
+            auto c = *in;
+            fquuid::parallel_sort(c, 4);
+            runtime_assert(c == expected, "test_sort() #3");
+        }
+    }
+
+    // every byte uniform
+    {
+        auto u = uuid_generator_v4::generate(mt);
+        std::vector<uuid> a(300'000, u), b = a;
+        fquuid::sort(a);
+        fquuid::parallel_sort(b, 4);
+        runtime_assert(std::all_of(a.begin(), a.end(), [&](auto& x) { return x == u; }), "test_sort() #5");
+        runtime_assert(std::all_of(b.begin(), b.end(), [&](auto& x) { return x == u; }), "test_sort() #6");
+    }
+
+    try {
+        std::vector<uuid> v(300), scratch(299);
+        fquuid::sort(v, scratch);
+        runtime_assert(0, "test_sort() #4");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_v7_index()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> all;
+
+    // 1000 ms with 0..19 keys each, 1 in 10 arrives late
+    uuid_v7_index index;
+    std::vector<uuid> late;
+    for (int64_t ms = 1'000'000; ms < 1'001'000; ms++) {
+        for (auto k = mt() % 20; k > 0; k--) {
+            auto u = uuid_generator_v7::generate(mt, ms);
+            all.push_back(u);
+            if (mt() % 10 == 0)
+                late.push_back(u);
+            else
+                runtime_assert(index.insert(u), "test_v7_index() #1");
+        }
+    }
+    for (auto& u : late)
+        runtime_assert(index.insert(u), "test_v7_index() #2");
+    runtime_assert(!index.insert(all.front()), "test_v7_index() #3");
+    runtime_assert(!index.insert(late.back()), "test_v7_index() #4");
+    runtime_assert(index.size() == all.size(), "test_v7_index() #5");
+
+    for (auto& u : all)
+        runtime_assert(index.contains(u), "test_v7_index() #6");
+    runtime_assert(!index.contains(uuid_generator_v7::generate(mt, 1'000'500)), "test_v7_index() #7");
+    runtime_assert(!index.contains(uuid{}), "test_v7_index() #8");
+
+    std::sort(all.begin(), all.end());
+    auto keys = index.keys();
+    runtime_assert(std::equal(keys.begin(), keys.end(), all.begin(), all.end()), "test_v7_index() #9");
+
+    auto check_range = [&](uuid_v7_index& ix, int64_t from, int64_t to) {
+        std::vector<uuid> expected;
+        for (auto& u : all) {
+            if (u.get_unix_ts_ms() >= from && u.get_unix_ts_ms() < to)
+                expected.push_back(u);
+        }
+        auto r = ix.range(from, to);
+        return std::equal(r.begin(), r.end(), expected.begin(), expected.end());
+    };
+    for (int i = 0; i < 100; i++) {
+        auto from = 999'990 + static_cast<int64_t>(mt() % 1020);
+        runtime_assert(check_range(index, from, from + static_cast<int64_t>(mt() % 50)), "test_v7_index() #10");
+    }
+    runtime_assert(check_range(index, 0, int64_t{1} << 48), "test_v7_index() #11");
+    runtime_assert(index.range(-5, int64_t{1} << 60).size() == all.size(), "test_v7_index() #12");
+    runtime_assert(index.range(1'000'010, 1'000'010).empty(), "test_v7_index() #13");
+    runtime_assert(index.range(1'000'010, 1'000'000).empty(), "test_v7_index() #14");
+
+    // bulk construction sorts and removes duplicates
+    auto shuffled = all;
+    shuffled.insert(shuffled.end(), all.begin(), all.begin() + 100);
+    std::shuffle(shuffled.begin(), shuffled.end(), mt);
+    uuid_v7_index built{shuffled};
+    runtime_assert(built.size() == all.size(), "test_v7_index() #15");
+    runtime_assert(check_range(built, 1'000'100, 1'000'200) && check_range(built, 0, int64_t{1} << 48), "test_v7_index() #16");
+    for (auto& u : all)
+        runtime_assert(built.contains(u), "test_v7_index() #17");
+
+    built.clear();
+    runtime_assert(built.empty() && !built.contains(all.front()), "test_v7_index() #18");
+    runtime_assert(built.range(0, int64_t{1} << 48).empty(), "test_v7_index() #19");
+}
+
+static void test_pg_copy()
+{
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto b = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    // COPY t (id uuid, parent uuid) TO STDOUT (FORMAT binary) with rows (a, b), (b, NULL)
+    const uint8_t golden_u8[] = {
+        'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xff, '\r', '\n', 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x02,
+        0x00, 0x00, 0x00, 0x10, 0x01, 0x92, 0x6c, 0x01, 0xba, 0x2c, 0x73, 0x15, 0xa1, 0x6a, 0x0e, 0x16, 0xd8, 0xa5, 0x1d, 0x4c,
+        0x00, 0x00, 0x00, 0x10, 0xd6, 0x04, 0x55, 0x7f, 0x67, 0x39, 0x48, 0x83, 0xb6, 0x27, 0xbc, 0x0a, 0x81, 0xb8, 0x4e, 0x97,
+        0x00, 0x02,
+        0x00, 0x00, 0x00, 0x10, 0xd6, 0x04, 0x55, 0x7f, 0x67, 0x39, 0x48, 0x83, 0xb6, 0x27, 0xbc, 0x0a, 0x81, 0xb8, 0x4e, 0x97,
+        0xff, 0xff, 0xff, 0xff,
+        0xff, 0xff,
+    };
+    auto golden = std::as_bytes(std::span(golden_u8));
+
+    uuid_pg_copy_writer writer(2);
+    std::vector<std::byte> buf(200);
+    size_t n = writer.write_header(buf);
+    const uuid values[] = { a, b, b, uuid{} };
+    const bool nulls[] = { false, false, false, true };
+    auto w = writer.write_rows(values, nulls, std::span(buf).subspan(n));
+    runtime_assert(w.values == 4, "test_pg_copy() #1");
+    n += w.bytes;
+    n += writer.write_trailer(std::span(buf).subspan(n));
+    runtime_assert(n == golden.size() && std::equal(golden.begin(), golden.end(), buf.begin()), "test_pg_copy() #2");
+
+    // fed a few bytes at a time, the unconsumed tail carried over
+    for (size_t step : { 1, 3, 7, 64 }) {
+        uuid_pg_copy_reader reader(2);
+        std::vector<std::byte> pending;
+        uuid out[4];
+        bool out_nulls[4];
+        size_t values_read = 0;
+        for (size_t i = 0; i < golden.size(); i += step) {
+            auto piece = golden.subspan(i, std::min(step, golden.size() - i));
+            pending.insert(pending.end(), piece.begin(), piece.end());
+            auto r = reader.read(pending, std::span(out).subspan(values_read), std::span(out_nulls).subspan(values_read));
+            pending.erase(pending.begin(), pending.begin() + r.bytes);
+            values_read += r.values;
+        }
+        runtime_assert(reader.finished() && pending.empty() && values_read == 4, "test_pg_copy() #3");
+        runtime_assert(out[0] == a && out[1] == b && out[2] == b && out[3].is_nil(), "test_pg_copy() #4");
+        runtime_assert(!out_nulls[0] && !out_nulls[2] && out_nulls[3], "test_pg_copy() #5");
+    }
+
+    // single column through small buffers, same bytes as the nullable path
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 1'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+    uuid_pg_copy_writer single;
+    runtime_assert(single.row_size() == 22, "test_pg_copy() #6");
+    std::vector<std::byte> fast(19), slow(19);
+    single.write_header(fast);
+    single.write_header(slow);
+    std::vector<std::byte> chunk(100);
+    for (size_t i = 0; i < keys.size();) {
+        auto r = single.write_rows(std::span(keys).subspan(i), chunk);
+        runtime_assert(r.values == 4 && r.bytes == 88, "test_pg_copy() #7");
+        fast.insert(fast.end(), chunk.begin(), chunk.begin() + r.bytes);
+        i += r.values;
+    }
+    std::vector<char> no_nulls(keys.size());
+    slow.resize(19 + 22 * keys.size());
+    single.write_rows(keys, std::span(reinterpret_cast<const bool*>(no_nulls.data()), no_nulls.size()), std::span(slow).subspan(19));
+    runtime_assert(fast == slow, "test_pg_copy() #8");
+    fast.resize(fast.size() + 2);
+    single.write_trailer(std::span(fast).last(2));
+
+    uuid_pg_copy_reader reader;
+    std::vector<uuid> back(keys.size());
+    auto r = reader.read(fast, back);
+    runtime_assert(r.values == keys.size() && r.bytes == fast.size() && reader.finished() && back == keys, "test_pg_copy() #9");
+
+    // output full: stops at a row boundary
+    uuid_pg_copy_reader partial;
+    r = partial.read(fast, std::span(back).first(10));
+    runtime_assert(r.values == 10 && r.bytes == 19 + 220 && !partial.finished(), "test_pg_copy() #10");
+
+    // header extension is skipped
+    std::vector<std::byte> ext(golden.begin(), golden.end());
+    ext[18] = std::byte{3};
+    ext.insert(ext.begin() + 19, 3, std::byte{0x55});
+    uuid_pg_copy_reader two(2);
+    uuid out[4];
+    bool out_nulls[4];
+    runtime_assert(two.read(ext, out, out_nulls).values == 4 && out[0] == a, "test_pg_copy() #11");
+
+    auto rejects = [&](const std::vector<std::byte>& bytes, size_t columns, bool with_nulls) {
+        try {
+            uuid_pg_copy_reader rd(columns);
+            rd.read(bytes, out, with_nulls ? std::span(out_nulls) : std::span<bool>{});
+            return false;
+        }
+        catch (std::invalid_argument&) {
+            return true;
+        }
+    };
+    std::vector<std::byte> bad(golden.begin(), golden.end());
+    runtime_assert(rejects(bad, 1, true), "test_pg_copy() #12");
+    runtime_assert(rejects(bad, 2, false), "test_pg_copy() #13");
+    bad[24] = std::byte{0x0f};
+    runtime_assert(rejects(bad, 2, true), "test_pg_copy() #14");
+    bad = std::vector<std::byte>(golden.begin(), golden.end());
+    bad[12] = std::byte{1}; // OIDs, flag bit 16
+    runtime_assert(rejects(bad, 2, true), "test_pg_copy() #15");
+    bad[0] = std::byte{'Q'};
+    runtime_assert(rejects(bad, 2, true), "test_pg_copy() #16");
+    try {
+        uuid_pg_copy_writer(2).write_rows(std::span(keys).first(3), chunk);
+        runtime_assert(0, "test_pg_copy() #17");
+    }
+    catch (std::invalid_argument&) {}
+
+    // flag bits 0-15 are critical, 17-31 may be ignored
+    bad = std::vector<std::byte>(golden.begin(), golden.end());
+    bad[14] = std::byte{1}; // bit 0
+    runtime_assert(rejects(bad, 2, true), "test_pg_copy() #18");
+    bad[14] = std::byte{0};
+    bad[13] = std::byte{0x80}; // bit 15
+    runtime_assert(rejects(bad, 2, true), "test_pg_copy() #19");
+    bad[13] = std::byte{0};
+    bad[11] = std::byte{0x80}; // bit 31
+    runtime_assert(!rejects(bad, 2, true), "test_pg_copy() #20");
+
+    // NULLs scattered over several batches, written through buffers that cut rows short
+    uuid_pg_copy_writer three(3);
+    std::vector<char> some_nulls(999);
+    for (size_t i = 0; i < some_nulls.size(); i++)
+        some_nulls[i] = i % 7 == 0 || i % 11 == 0;
+    auto nulls3 = std::span(reinterpret_cast<const bool*>(some_nulls.data()), some_nulls.size());
+    std::vector<std::byte> copy(19);
+    three.write_header(copy);
+    std::vector<std::byte> piece(333);
+    for (size_t i = 0; i < some_nulls.size();) {
+        auto w3 = three.write_rows(std::span(keys).subspan(i, 999 - i), nulls3.subspan(i), piece);
+        copy.insert(copy.end(), piece.begin(), piece.begin() + w3.bytes);
+        i += w3.values;
+    }
+    copy.resize(copy.size() + 2);
+    three.write_trailer(std::span(copy).last(2));
+
+    uuid_pg_copy_reader read3(3);
+    std::vector<uuid> back3(999);
+    std::vector<char> back_nulls(999);
+    r = read3.read(copy, back3, std::span(reinterpret_cast<bool*>(back_nulls.data()), back_nulls.size()));
+    bool same = r.values == 999 && read3.finished() && back_nulls == some_nulls;
+    for (size_t i = 0; i < 999; i++)
+        same = same && (some_nulls[i] ? back3[i].is_nil() : back3[i] == keys[i]);
+    runtime_assert(same, "test_pg_copy() #21");
+}
+
+static void test_arrow()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 1'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    keys[0] = a;
+
+    ArrowSchema schema;
+    export_arrow_schema(&schema, true, "id");
+    runtime_assert(std::string_view(schema.format) == "w:16" && std::string_view(schema.name) == "id", "test_arrow() #1");
+    runtime_assert(is_arrow_uuid_extension(schema), "test_arrow() #2");
+
+    ArrowArray array;
+    export_arrow_array(keys, &array);
+    runtime_assert(array.length == 1'000 && array.null_count == 0 && array.n_buffers == 2, "test_arrow() #3");
+    auto bytes = arrow_uuid_bytes(schema, array);
+    runtime_assert(bytes.size() == 16'000 && bytes[0] == std::byte{0x01} && bytes[15] == std::byte{0x4c}, "test_arrow() #4");
+    runtime_assert(import_arrow(schema, array) == keys, "test_arrow() #5");
+
+    // offset and validity bitmap set by another producer
+    const uint8_t validity[] = { 0b1111'1101, 0xff };
+    const void* buffers[] = { validity, array.buffers[1] };
+    ArrowArray slice = array;
+    slice.offset = 3;
+    slice.length = 10;
+    slice.null_count = 1;
+    slice.buffers = buffers;
+    auto sliced = import_arrow(schema, slice);
+    runtime_assert(sliced.size() == 10 && sliced[0] == keys[3] && sliced[9] == keys[12], "test_arrow() #6");
+    slice.offset = 1; // bit 1 clear
+    sliced = import_arrow(schema, slice);
+    runtime_assert(sliced[0].is_nil() && sliced[1] == keys[2], "test_arrow() #7");
+
+    array.release(&array);
+    runtime_assert(array.release == nullptr, "test_arrow() #8");
+    schema.release(&schema);
+
+    // zero-copy export of big-endian records
+    auto owned = std::make_shared<std::vector<std::byte>>(16 * keys.size());
+    store_many(keys, std::span(*owned));
+    export_arrow_array(std::span<const std::byte>(*owned), owned, &array);
+    runtime_assert(array.buffers[1] == owned->data() && owned.use_count() == 2, "test_arrow() #9");
+    export_arrow_schema(&schema, false);
+    runtime_assert(!is_arrow_uuid_extension(schema) && schema.metadata == nullptr, "test_arrow() #10");
+    runtime_assert(import_arrow(schema, array) == keys, "test_arrow() #11");
+    array.release(&array);
+    runtime_assert(owned.use_count() == 1, "test_arrow() #12");
+
+    auto moved = *owned;
+    auto data = moved.data();
+    export_arrow_array(std::move(moved), &array);
+    runtime_assert(array.buffers[1] == data && import_arrow(schema, array) == keys, "test_arrow() #13");
+
+    ArrowSchema other = schema;
+    other.format = "z";
+    try {
+        (void)import_arrow(other, array);
+        runtime_assert(0, "test_arrow() #14");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        export_arrow_array(std::span(*owned).first(15), owned, &array);
+        runtime_assert(0, "test_arrow() #15");
+    }
+    catch (std::invalid_argument&) {}
+    array.release(&array);
+    schema.release(&schema);
+}
+
+static void test_prefix_index()
+{
+    constexpr auto a = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    constexpr auto b = uuid{S("01926c01-ba2c-798b-8dcc-04e45ae6188b")};
+    constexpr auto c = uuid{S("01926c01-ba2d-708e-90a1-cc63e523be32")};
+    constexpr auto d = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+
+    uuid_prefix_index index(std::vector<uuid>{ d, c, a, b, a });
+    runtime_assert(index.size() == 4 && std::is_sorted(index.keys().begin(), index.keys().end()), "test_prefix_index() #1");
+
+    runtime_assert(index.resolve("d") == d && index.resolve("D604557F-67") == d, "test_prefix_index() #2");
+    runtime_assert(index.resolve("01926c01-ba2c-73") == a && index.resolve("01926c01ba2c79") == b, "test_prefix_index() #3");
+    runtime_assert(!index.resolve("01926c01-ba2c-7") && index.find_prefix("01926c01-ba2c-7").size() == 2, "test_prefix_index() #4");
+    runtime_assert(!index.resolve("0192") && index.find_prefix("0192").size() == 3, "test_prefix_index() #5");
+    runtime_assert(!index.resolve("e") && index.find_prefix("e").empty() && index.find_prefix("").size() == 4, "test_prefix_index() #6");
+    runtime_assert(index.resolve("d604557f-6739-4883-b627-bc0a81b84e97") == d, "test_prefix_index() #7");
+
+    runtime_assert(index.shortest_unique_prefix(d) == 1 && index.shortest_unique_prefix(c) == 12, "test_prefix_index() #8");
+    runtime_assert(index.shortest_unique_prefix(a) == 14 && index.shortest_unique_prefix(b) == 14, "test_prefix_index() #9");
+    auto lengths = index.shortest_unique_prefixes();
+    runtime_assert((lengths == std::vector<uint8_t>{ 14, 14, 12, 1 }), "test_prefix_index() #10");
+    auto full = index.abbreviate(d, 40); // min_digits past 32 is the whole key
+    runtime_assert(index.abbreviate(d) == "d" && index.abbreviate(d, 7) == "d604557" && full.size() == 36, "test_prefix_index() #11");
+    runtime_assert(index.abbreviate(c) == "01926c01-ba2d" && index.abbreviate(a) == "01926c01-ba2c-73", "test_prefix_index() #12");
+
+    try {
+        (void)index.resolve("01926g");
+        runtime_assert(0, "test_prefix_index() #13");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        (void)index.resolve("d604557f-6739-4883-b627-bc0a81b84e970");
+        runtime_assert(0, "test_prefix_index() #14");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        (void)index.shortest_unique_prefix(uuid{});
+        runtime_assert(0, "test_prefix_index() #15");
+    }
+    catch (std::out_of_range&) {}
+
+    // against a scan over the formatted keys
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 5'000; i++)
+        keys.push_back(uuid_generator_v7::generate(mt, 0x01926c01'ba2c + i / 16));
+    for (int i = 0; i < 5'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+    uuid_prefix_index big(keys);
+    std::vector<std::string> strings;
+    for (auto& k : big.keys())
+        strings.push_back(k.to_string());
+    auto all = big.shortest_unique_prefixes();
+    bool ok = true;
+    for (size_t i = 0; i < big.size(); i += 37) {
+        auto s = big.abbreviate(big.keys()[i]);
+        ok = ok && all[i] == big.shortest_unique_prefix(i) && big.resolve(s) == big.keys()[i];
+        auto shorter = s.substr(0, s.size() - 1 - (s.size() > 1 && s[s.size() - 2] == '-'));
+        auto matches = std::count_if(strings.begin(), strings.end(), [&](auto& t) { return t.starts_with(shorter); });
+        ok = ok && (all[i] == 1 || matches > 1) && big.find_prefix(shorter).size() == static_cast<size_t>(matches);
+    }
+    runtime_assert(ok, "test_prefix_index() #16");
+    runtime_assert(uuid_prefix_index().find_prefix("01").empty(), "test_prefix_index() #17");
+}
+
+static void test_v7_column()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> sorted, jittered, mixed;
+    for (int i = 0; i < 10'000; i++) {
+        sorted.push_back(uuid_generator_v7::generate(mt, 1'700'000'000'000 + i / 8));
+        jittered.push_back(uuid_generator_v7::generate(mt, 1'700'000'000'000 + i / 8 + static_cast<int>(mt() % 50) - 25));
+        mixed.push_back(i % 1'000 == 999 ? uuid_generator_v4::generate(mt) : jittered.back());
+    }
+    // timestamps far apart
+    sorted.push_back(uuid_generator_v7::generate(mt, 0));
+    sorted.push_back(uuid_generator_v7::generate(mt, (int64_t{1} << 48) - 1));
+    sorted.push_back(uuid_generator_v7::generate(mt, 0));
+    std::ranges::sort(sorted.begin(), sorted.end() - 3);
+
+    for (auto* keys : { &sorted, &jittered, &mixed }) {
+        for (size_t block_size : { 1, 3, 4, 5, 64, 1024, 100'000 }) {
+            auto bytes = encode_v7_column(*keys, block_size);
+            uuid_v7_column_view column(bytes);
+            runtime_assert(column.size() == keys->size(), "test_v7_column() #1");
+            runtime_assert(column.block_count() == (keys->size() + block_size - 1) / block_size, "test_v7_column() #2");
+            runtime_assert(column.to_vector() == *keys, "test_v7_column() #3");
+
+            std::vector<uuid> block(block_size);
+            auto b = column.block_count() / 2;
+            runtime_assert(column.decode_block(b, block) == column.block_length(b), "test_v7_column() #4");
+            runtime_assert(std::equal(block.begin(), block.begin() + column.block_length(b), keys->begin() + b * block_size), "test_v7_column() #5");
+
+            for (size_t i = 0; i < keys->size(); i += 997)
+                runtime_assert(column[i] == (*keys)[i], "test_v7_column() #6");
+            runtime_assert(column.at(keys->size() - 1) == keys->back(), "test_v7_column() #7");
+        }
+    }
+
+    // sorted v7: timestamp deltas take a bit or two
+    runtime_assert(encode_v7_column(std::span(sorted).first(10'000)).size() < 10'000 * 48 / 5, "test_v7_column() #8");
+    runtime_assert(encode_v7_column(std::vector<uuid>(1'000, uuid{})).size() > 16'000, "test_v7_column() #9");
+
+    auto empty = uuid_v7_column_view(encode_v7_column({}));
+    runtime_assert(empty.empty() && empty.block_count() == 0 && empty.to_vector().empty(), "test_v7_column() #10");
+
+    auto bytes = encode_v7_column(jittered, 256);
+    uuid_v7_column_view column(bytes);
+    try {
+        (void)column.at(jittered.size());
+        runtime_assert(0, "test_v7_column() #11");
+    }
+    catch (std::out_of_range&) {}
+    try {
+        std::vector<uuid> small(255);
+        column.decode_block(0, small);
+        runtime_assert(0, "test_v7_column() #12");
+    }
+    catch (std::invalid_argument&) {}
+
+    for (size_t cut : { size_t{0}, size_t{8}, size_t{40}, bytes.size() - 1 }) {
+        try {
+            uuid_v7_column_view bad{std::span(bytes).first(cut)};
+            runtime_assert(0, "test_v7_column() #13");
+        }
+        catch (std::invalid_argument&) {}
+    }
+    try {
+        auto bad = bytes;
+        bad[8] = std::byte{1}; // key count
+        uuid_v7_column_view v(bad);
+        runtime_assert(0, "test_v7_column() #14");
+    }
+    catch (std::invalid_argument&) {}
+    try {
+        encode_v7_column(jittered, 0);
+        runtime_assert(0, "test_v7_column() #15");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_set_file()
+{
+    namespace fs = std::filesystem;
+    auto dir = fs::temp_directory_path() / ("fquuid_test_" + uuid_generator_v4{}().to_string());
+    fs::create_directory(dir);
+    auto path = dir / "set.fqs";
+
+    std::mt19937_64 mt;
+    std::vector<uuid> keys;
+    for (int i = 0; i < 10'000; i++)
+        keys.push_back(uuid_generator_v4::generate(mt));
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    // external merge of 7 runs, duplicates across runs
+    {
+        uuid_set_file_writer w{path, 3'000, 64};
+        w.add(keys);
+        w.add(std::span(keys).first(500));
+        runtime_assert(w.finish() == keys.size(), "test_set_file() #1");
+    }
+    runtime_assert(std::distance(fs::directory_iterator(dir), fs::directory_iterator()) == 1, "test_set_file() #2");
+
+    {
+        uuid_set_file f{path};
+        runtime_assert(f.size() == keys.size(), "test_set_file() #3");
+        runtime_assert(fs::file_size(path) == 64 + (10'000 + 157) * 16, "test_set_file() #4");
+
+        std::vector<uuid> loaded(f.size());
+        load_many(f.records(), loaded);
+        runtime_assert(loaded == expected, "test_set_file() #5");
+
+        for (auto& u : keys)
+            runtime_assert(f.contains(u), "test_set_file() #6");
+        for (int i = 0; i < 1'000; i++)
+            runtime_assert(!f.contains(uuid_generator_v4::generate(mt)), "test_set_file() #7");
+        runtime_assert(!f.contains(uuid{}), "test_set_file() #8");
+
+        runtime_assert(f.lower_bound(uuid{}) == 0, "test_set_file() #9");
+        runtime_assert(f.lower_bound(expected[1234]) == 1234, "test_set_file() #10");
+        runtime_assert(f[1234] == expected[1234], "test_set_file() #11");
+
+        auto r = f.range(expected[100], expected[200]);
+        runtime_assert(r.size() == 100 * 16, "test_set_file() #12");
+        runtime_assert(uuid_view::at(r, 0) == expected[100] && uuid_view::at(r, 99) == expected[199], "test_set_file() #13");
+        runtime_assert(f.range(expected[200], expected[100]).empty(), "test_set_file() #14");
+        runtime_assert(f.range(uuid{}, uuid{S("ffffffff-ffff-ffff-ffff-ffffffffffff")}).size() == f.records().size(), "test_set_file() #15");
+    }
+
+    // single run in memory, empty set
+    {
+        uuid_set_file_writer w{path};
+        w.add(keys[0]);
+        w.add(keys[0]);
+        w.add(keys[1]);
+        runtime_assert(w.finish() == 2, "test_set_file() #16");
+        uuid_set_file f{path};
+        runtime_assert(f.size() == 2 && f.contains(keys[0]) && f.contains(keys[1]), "test_set_file() #17");
+
+        uuid_set_file_writer e{path};
+        runtime_assert(e.finish() == 0, "test_set_file() #18");
+        uuid_set_file g{path};
+        runtime_assert(g.empty() && !g.contains(keys[0]), "test_set_file() #19");
+        runtime_assert(g.range(uuid{}, keys[0]).empty(), "test_set_file() #20");
+    }
+
+    // truncated and foreign files
+    {
+        uuid_set_file_writer w{path};
+        w.add(keys);
+        w.finish();
+        fs::resize_file(path, fs::file_size(path) - 16);
+        try {
+            uuid_set_file f{path};
+            runtime_assert(0, "test_set_file() #21");
+        }
+        catch (std::runtime_error&) {}
+
+        std::ofstream{dir / "text"} << "not a uuid set file, but long enough to hold a header of 64 bytes";
+        try {
+            uuid_set_file f{dir / "text"};
+            runtime_assert(0, "test_set_file() #22");
+        }
+        catch (std::runtime_error&) {}
+
+        try {
+            uuid_set_file f{dir / "missing"};
+            runtime_assert(0, "test_set_file() #23");
+        }
+        catch (std::runtime_error&) {}
+    }
+
+    fs::remove_all(dir);
+}
+
+static void test_static_set()
+{
+    std::mt19937_64 mt;
+
+    // every tree shape up to 3 full levels, then larger ones
+    for (size_t n : { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 15, 16, 17, 100, 1'000, 4'097 }) {
+        std::vector<uuid> keys;
+        for (size_t i = 0; i < n; i++)
+            keys.push_back(uuid_generator_v4::generate(mt));
+
+        // upper words tie, only the lower word differs
+        for (size_t i = 0; i < n / 4; i++) {
+            auto b = keys[i].to_bytes();
+            b[15] ^= std::byte{1};
+            keys.push_back(uuid{b});
+        }
+        auto expected = keys;
+        std::sort(expected.begin(), expected.end());
+        expected.erase(std::unique(expected.begin(), expected.end()), expected.end());
+
+        auto input = keys;
+        input.insert(input.end(), keys.begin(), keys.begin() + n / 2); // duplicates
+        std::shuffle(input.begin(), input.end(), mt);
+        uuid_static_set set{input};
+
+        runtime_assert(set.size() == expected.size(), "test_static_set() #1");
+        runtime_assert(set.empty() == (n == 0), "test_static_set() #2");
+        runtime_assert(set.to_vector() == expected, "test_static_set() #3");
+
+        std::vector<uuid> lookup;
+        for (auto& u : expected) {
+            runtime_assert(set.contains(u), "test_static_set() #4");
+            auto b = u.to_bytes();
+            b[15] ^= std::byte{2};
+            if (!std::binary_search(expected.begin(), expected.end(), uuid{b})) {
+                runtime_assert(!set.contains(uuid{b}), "test_static_set() #5");
+                lookup.push_back(uuid{b});
+            }
+            lookup.push_back(u);
+        }
+        runtime_assert(!set.contains(uuid{}), "test_static_set() #6");
+        runtime_assert(!set.contains(uuid{S("ffffffff-ffff-ffff-ffff-ffffffffffff")}), "test_static_set() #7");
+
+        auto found = std::make_unique<bool[]>(lookup.size());
+        auto hits = set.contains_many(lookup, std::span(found.get(), lookup.size()));
+        runtime_assert(hits == expected.size(), "test_static_set() #8");
+        for (size_t i = 0; i < lookup.size(); i++)
+            runtime_assert(found[i] == set.contains(lookup[i]), "test_static_set() #9");
+    }
+
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    constexpr auto b = uuid{S("01926c01-ba2c-7315-a16a-0e16d8a51d4c")};
+    uuid_static_set s {a, b, a};
+    runtime_assert(s.size() == 2 && s.contains(a) && s.contains(b) && !s.contains(uuid{}), "test_static_set() #10");
+
+    try {
+        bool found[1];
+        s.contains_many(std::vector<uuid>{a, b}, found);
+        runtime_assert(0, "test_static_set() #11");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+template <class Filter>
+static void test_filter_impl(const std::vector<uuid>& keys, const std::vector<uuid>& others, const Filter& f, double max_fpp)
+{
+    for (auto& u : keys)
+        runtime_assert(f.may_contain(u), "test_filter() #1");
+
+    size_t fp = 0;
+    for (auto& u : others)
+        fp += f.may_contain(u);
+    runtime_assert(fp < others.size() * max_fpp, "test_filter() #2");
+
+    auto found = std::make_unique<bool[]>(others.size());
+    runtime_assert(f.may_contain_many(others, std::span(found.get(), others.size())) == fp, "test_filter() #3");
+    for (size_t i = 0; i < others.size(); i++)
+        runtime_assert(found[i] == f.may_contain(others[i]), "test_filter() #4");
+
+    auto bytes = f.to_bytes();
+    runtime_assert(bytes.size() == f.serialized_size(), "test_filter() #5");
+    auto g = Filter::from_bytes(bytes);
+    runtime_assert(g.to_bytes() == bytes, "test_filter() #6");
+    for (size_t i = 0; i < others.size(); i++)
+        runtime_assert(g.may_contain(others[i]) == found[i], "test_filter() #7");
+
+    try {
+        Filter::from_bytes(std::span(bytes).first(bytes.size() - 1));
+        runtime_assert(0, "test_filter() #8");
+    }
+    catch (std::invalid_argument&) {}
+
+    try {
+        bytes[0] = std::byte{'X'};
+        Filter::from_bytes(bytes);
+        runtime_assert(0, "test_filter() #9");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_filter()
+{
+    std::mt19937_64 mt;
+    std::vector<uuid> v4, v7, others;
+    for (int i = 0; i < 100'000; i++) {
+        v4.push_back(uuid_generator_v4::generate(mt));
+        v7.push_back(uuid_generator_v7::generate(mt, 1'700'000'000'000 + i / 100));
+        others.push_back(uuid_generator_v7::generate(mt, 1'700'000'000'000 + i / 100));
+    }
+
+    {
+        uuid_basic_bloom_filter<uuid_trusted_v4_hash> f{v4.size()};
+        f.insert(v4);
+        test_filter_impl(v4, others, f, 0.01);
+    }
+    {
+        uuid_bloom_filter f{v7.size()};
+        f.insert(v7);
+        test_filter_impl(v7, others, f, 0.01);
+        runtime_assert(f.size_in_bytes() == 4'688 * 32, "test_filter() #10");
+    }
+    {
+        uuid_basic_fuse_filter<uuid_trusted_v4_hash> f{v4};
+        test_filter_impl(v4, others, f, 0.006);
+    }
+    {
+        auto keys = v7;
+        keys.insert(keys.end(), v7.begin(), v7.begin() + 1'000); // duplicates
+        uuid_fuse_filter f{keys};
+        test_filter_impl(v7, others, f, 0.006);
+        runtime_assert(f.size_in_bytes() < v7.size() * 12 / 10, "test_filter() #11");
+    }
+
+    // tiny filters
+    for (size_t n : { 0, 1, 2, 3, 10 }) {
+        std::vector<uuid> keys(v7.begin(), v7.begin() + n);
+        uuid_fuse_filter f{keys};
+        for (auto& u : keys)
+            runtime_assert(f.may_contain(u), "test_filter() #12");
+        uuid_bloom_filter b{n};
+        b.insert(keys);
+        for (auto& u : keys)
+            runtime_assert(b.may_contain(u), "test_filter() #13");
+    }
+    runtime_assert(uuid_fuse_filter::from_bytes(uuid_fuse_filter{}.to_bytes()).size_in_bytes() == 12, "test_filter() #14");
+
+    // (segment count + 2) * segment length must not wrap in 32 bits
+    try {
+        auto bytes = uuid_fuse_filter{}.to_bytes();
+        detail::store_le(bytes.data() + 16, 4, 4);
+        detail::store_le(bytes.data() + 20, 0xffff'ffff, 4);
+        detail::store_le(bytes.data() + 24, 4, 8);
+        bytes.resize(bytes.size() - 12 + 4);
+        uuid_fuse_filter::from_bytes(bytes);
+        runtime_assert(0, "test_filter() #15");
+    }
+    catch (std::invalid_argument&) {}
+}
+
+static void test_hash()
+{
+    // the portable multiply must agree with the 128-bit integer one
+    static_assert(detail::mul_fold(0xffff'ffff'ffff'ffff, 0xffff'ffff'ffff'ffff) == 0xffff'ffff'ffff'ffff, "test_hash() #1");
+    static_assert(detail::mul_fold(0x0123'4567'89ab'cdef, 0xfedc'ba98'7654'3210) == 0x2317'228f'4816'5bb2, "test_hash() #2");
+
+    constexpr auto a = uuid{S("d604557f-6739-4883-b627-bc0a81b84e97")};
+    if constexpr (sizeof(size_t) == 8) {
+        static_assert(a.hash() == 0xb233'5009'e4b6'656c, "test_hash() #3");
+        static_assert(uuid{}.hash() == 0x2e1f'f1e8'aa1a'8262, "test_hash() #4");
+    }
+    static_assert(a.hash() != a.hash(1), "test_hash() #5");
+    static_assert(a.hash(0) == a.hash(), "test_hash() #6");
+    static_assert(uuid_seeded_hash{7}(a) == a.hash(7), "test_hash() #7");
+    static_assert(uuid_trusted_v4_hash{}(a) == static_cast<size_t>(0xd604557f67394883 ^ 0xb627bc0a81b84e97), "test_hash() #8");
+
+    runtime_assert(std::hash<uuid>{}(a) == a.hash(), "test_hash() #9");
+    runtime_assert(uuid_hash{}(a) == a.hash(), "test_hash() #10");
+    runtime_assert(uuid_seeded_hash{}.seed() == uuid_seeded_hash{}.seed(), "test_hash() #11");
+
+    // flipping one input bit changes about half of the output bits
+    auto bytes = a.to_bytes();
+    int changed = 0;
+    for (int i = 0; i < 128; i++) {
+        auto b = bytes;
+        b[i / 8] ^= std::byte(1 << (i % 8));
+        changed += std::popcount(static_cast<uint64_t>(a.hash() ^ uuid{b}.hash()));
+    }
+    runtime_assert(changed > 128 * 24 && changed < 128 * 40, "test_hash() #12");
+
+    // v7 keys from one millisecond fill a power-of-two table like random keys (~2590 of 4096)
+    std::mt19937_64 rng;
+    auto v7 = uuid_generator_v7::generate(rng);
+    std::vector<bool> used(4096);
+    for (int i = 0; i < 4096; i++) {
+        auto b = v7.to_bytes();
+        b[15] = std::byte(i);
+        b[14] = std::byte(i >> 8);
+        used[uuid{b}.hash() & 4095] = true;
+    }
+    runtime_assert(std::count(used.begin(), used.end(), true) > 2400, "test_hash() #13");
+
+    // no half of the key can zero a product and hide the other half
+    std::vector<bool> used_upper(4096), used_lower(4096);
+    for (uint64_t i = 0; i < 4096; i++) {
+        detail::uuid_u128 u, l;
+        u.upper(0xa076'1d64'78bd'642f);
+        u.lower(i * 0x9e37'79b9'7f4a'7c15);
+        l.upper(i * 0x9e37'79b9'7f4a'7c15);
+        l.lower(0xe703'7ed1'a0b4'28db);
+        used_upper[u.hash() & 4095] = true;
+        used_lower[l.hash() & 4095] = true;
+    }
+    runtime_assert(std::count(used_upper.begin(), used_upper.end(), true) > 2400, "test_hash() #14");
+    runtime_assert(std::count(used_lower.begin(), used_lower.end(), true) > 2400, "test_hash() #15");
+
+    // a change in the lower half alone moves the hash differently under different seeds
+    constexpr auto c = uuid{S("d604557f-6739-4883-b627-bc0a81b84e96")};
+    static_assert((a.hash(1) ^ c.hash(1)) != (a.hash(2) ^ c.hash(2)), "test_hash() #16");
 }
 
 #define V_TO_S(v) #v
@@ -513,11 +2411,41 @@ int main(int argc, char** argv)
         test_parse_error_unicode();
         test_string();
         test_string_error();
+        test_fixed_string();
         test_ostream();
+        test_istream();
+        test_formatter();
+        test_string_format();
+        test_parse_urn();
+        test_base64url();
+        test_base32();
+        test_base58();
+        test_encoding_error();
+        test_scanner();
+        test_stream_scanner();
         test_bytelike();
         test_binary();
         test_binary_error();
+        test_guid_binary();
+        test_view();
+        test_bulk_binary();
         test_map();
+        test_hash();
+        test_sort();
+        test_v7_index();
+        test_prefix_index();
+        test_v7_column();
+        test_arrow();
+        test_pg_copy();
+        test_set_file();
+        test_static_set();
+        test_filter();
+        test_flat_set();
+        test_flat_map();
+        test_concurrent_map();
+        test_dictionary();
+        test_routing();
+        test_atomic_uuid();
 
         std::cout << "All tests successful.\t"
                   << TO_S(CHAR_T)
@@ -33,9 +33,7 @@ enum class gen_mode {
 
 static void println(const fquuid::uuid& u)
 {
-    std::array<char, 37> buf;
-    u.write_string(buf);
-    puts(buf.data());
+    puts(u.to_chars().c_str());
 }
 
 int main(int argc, char** argv)